@@ -44,6 +44,7 @@ namespace Fig
         ReturnStmt,
         BreakStmt,
         ContinueStmt,
+        ImportStmt, // import std.io;
 
         /* Type Expressions */
         TypeExpr,
@@ -49,7 +49,8 @@ namespace Fig
 
         CallExpr(Expr *_callee, FnCallArgs _args) : callee(_callee), args(std::move(_args))
         {
-            type = AstType::CallExpr;
+            type     = AstType::CallExpr;
+            location = _callee->location;
         }
 
         virtual String toString() const override
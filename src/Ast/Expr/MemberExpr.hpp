@@ -16,6 +16,9 @@ namespace Fig
         Expr  *target; // 访问对象
         String name;   // 成员名字
 
+        // 语义分析后填充：target 是 import 的标准库模块时为原生函数编号，否则 -1
+        int nativeId = -1;
+
         MemberExpr()
         {
             type = AstType::MemberExpr;
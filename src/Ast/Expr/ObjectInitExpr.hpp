@@ -17,6 +17,8 @@ namespace Fig
         {
             String name;
             Expr  *value;
+
+            int fieldIndex = -1; // 语义分析后填充：对应的字段槽位 (具名、按顺序、简写三种写法统一到这里)
         };
         TypeExpr     *typeExpr;
         DynArray<Arg> args;
@@ -36,6 +36,7 @@ namespace Fig
 
         int protoIndex = -1; // 在CompiledModule扁平化protos的下标
         DynArray<UpvalueInfo> upvalues;
+        DynArray<Symbol *>    captureTargets; // 与 upvalues 一一对应：被捕获的原始局部变量
 
         FnDefStmt() { type = AstType::FnDefStmt; }
         FnDefStmt(bool _p, String _n, DynArray<Param *> _pa, TypeExpr *_rt, BlockStmt *_b, SourceLocation _loc)
@@ -0,0 +1,39 @@
+/*!
+    @file src/Ast/Stmt/ImportStmt.hpp
+    @brief 导入语句定义：import std.io;
+*/
+
+#pragma once
+
+#include <Ast/Base.hpp>
+
+namespace Fig
+{
+    struct ImportStmt final : public Stmt
+    {
+        DynArray<String> path; // std.io => ["std", "io"]
+
+        ImportStmt()
+        {
+            type = AstType::ImportStmt;
+        }
+
+        ImportStmt(DynArray<String> _path, SourceLocation _location) : path(std::move(_path))
+        {
+            type     = AstType::ImportStmt;
+            location = std::move(_location);
+        }
+
+        virtual String toString() const override
+        {
+            String joined;
+            for (std::size_t i = 0; i < path.size(); ++i)
+            {
+                if (i != 0)
+                    joined += ".";
+                joined += path[i];
+            }
+            return std::format("<ImportStmt '{}'>", joined);
+        }
+    };
+} // namespace Fig
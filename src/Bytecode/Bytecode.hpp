@@ -9,17 +9,29 @@
 #include <Object/ObjectBase.hpp>
 #include <Core/SourceLocations.hpp>
 
+#include <algorithm>
 #include <cstdint>
 
 
 namespace Fig
 {
+    struct FunctionObject;
+    struct StringObject;
+    struct BigIntObject;
+    struct StructObject;
+    struct Proto;
+
+    namespace Jit
+    {
+        struct JitCode;
+        struct Trace;
+    }
+
     using Instruction = std::uint32_t;
 
     enum class OpCode : std::uint8_t
     {
         Exit,
-        Exit_MaxRecursionDepthExceeded,
 
         LoadK,
         LoadTrue,
@@ -29,12 +41,44 @@ namespace Fig
         FastCall,
         Call,
         Return,
+        TailFastCall, // A: protoIdx, B: baseReg, C: argc，复用当前 CallFrame
+        TailCall,     // A: 闭包寄存器, B: baseReg, C: argc，复用当前 CallFrame
+        CallNative,   // A: 原生函数编号, B: baseReg, C: argc，结果写回 R[B]
 
         LoadFn,
+        LoadNative, // A = 原生函数对象 Bx (import 的模块成员作为值使用)
 
         Jmp,
         JmpIfFalse,
 
+        // 比较-跳转融合指令, 由 Peephole 从 Cmp + JmpIfFalse 改写而来
+        // A: lhs, B: rhs, sC: 条件不成立时的跳转偏移
+        JmpIfNotLess,
+        JmpIfNotLessEqual,
+        JmpIfNotEqual,
+        JmpIfEqual,
+
+        IntJmpIfNotLess,
+        IntJmpIfNotLessEqual,
+        IntJmpIfNotEqual,
+        IntJmpIfEqual,
+
+        // A: lhs, sB: 立即数
+        JmpIfNotEqualI,
+        JmpIfEqualI,
+        JmpIfNotGreaterI,
+        JmpIfNotLessI,
+        JmpIfNotGreaterEqualI,
+        JmpIfNotLessEqualI,
+
+        // A: lhs, B: 常量下标
+        JmpIfNotEqualK,
+        JmpIfEqualK,
+        JmpIfNotGreaterK,
+        JmpIfNotLessK,
+        JmpIfNotGreaterEqualK,
+        JmpIfNotLessEqualK,
+
         Mov,
 
         Add,
@@ -49,6 +93,35 @@ namespace Fig
         IntFastMul,
         IntFastDiv,
 
+        IntFastEqual,
+        IntFastNotEqual,
+        IntFastGreater,
+        IntFastLess,
+        IntFastGreaterEqual,
+        IntFastLessEqual,
+
+        // 立即数 / 常量池操作数: A = R[B] op sC | K[C]
+        AddI,
+        SubI,
+        MulI,
+        AddK,
+        SubK,
+        MulK,
+
+        EqualI,
+        NotEqualI,
+        GreaterI,
+        LessI,
+        GreaterEqualI,
+        LessEqualI,
+
+        EqualK,
+        NotEqualK,
+        GreaterK,
+        LessK,
+        GreaterEqualK,
+        LessEqualK,
+
         Equal,
         NotEqual,
         Greater,
@@ -56,11 +129,45 @@ namespace Fig
         GreaterEqual,
         LessEqual,
 
+        // 运行时特化 (quickening)：泛型指令观测到稳定的操作数类型后由 VM 原地改写，
+        // 守卫失败时改回泛型指令。编译器不直接生成
+        AddInt,
+        AddDouble,
+        SubInt,
+        SubDouble,
+        MulInt,
+        MulDouble,
+
+        GreaterInt,
+        GreaterDouble,
+        LessInt,
+        LessDouble,
+        GreaterEqualInt,
+        GreaterEqualDouble,
+        LessEqualInt,
+        LessEqualDouble,
+
+        JmpIfNotLessInt,
+        JmpIfNotLessDouble,
+        JmpIfNotLessEqualInt,
+        JmpIfNotLessEqualDouble,
+
         GetGlobal,
         SetGlobal,
         GetUpval,
         SetUpval,
         Copy,
+        GetCapture, // A = 闭包按值捕获的第 B 个槽位
+
+        // 实例字段：接收者的结构体静态已知时按槽位下标访问 (期望的结构体由编译器预置在 fieldCache，klass 不同时按名查找)
+        GetField, // A = R[B].fields[C]
+        SetField, // R[A].fields[B] = R[C]
+        // 接收者为 Any：按字段名 (常量池字符串) 访问，经调用点内联缓存解析槽位
+        GetFieldK, // A = R[B].<K[C]>
+        SetFieldK, // R[A].<K[B]> = R[C]
+
+        // A = new K[Bx]{R[A], ..., R[A + fieldCount - 1]}：字段值已由编译器按槽位排好，结果写回 R[A]
+        NewInstance,
 
         Count
     };
@@ -79,6 +186,13 @@ namespace Fig
                    | (static_cast<std::uint32_t>(b) << 16) | (static_cast<std::uint32_t>(c) << 24);
         }
 
+        [[nodiscard]] inline constexpr Instruction iABsC(OpCode op, std::uint8_t a, std::uint8_t b, std::int8_t sc)
+        {
+            return static_cast<std::uint32_t>(op) | (static_cast<std::uint32_t>(a) << 8)
+                   | (static_cast<std::uint32_t>(b) << 16)
+                   | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(sc)) << 24);
+        }
+
         [[nodiscard]] inline constexpr Instruction iAsBx(OpCode op, std::uint8_t a, std::int16_t sbx)
         {
             return static_cast<std::uint32_t>(op) | (static_cast<std::uint32_t>(a) << 8)
@@ -90,6 +204,39 @@ namespace Fig
     {
         uint8_t index;
         bool    isLocal;
+        bool    byValue = false; // 捕获后不再被写入：LoadFn 时拷贝值，不分配 Upvalue
+    };
+
+    // 追踪 JIT：以循环头 pc 为下标的回边计数与已编译的 trace
+    struct LoopAnchor
+    {
+        std::uint32_t hits   = 0;
+        std::uint16_t aborts = 0; // 记录失败次数，达到上限后不再尝试
+        Jit::Trace   *trace  = nullptr;
+    };
+
+    // 运行时特化：每条指令的观测计数 (按 pc 下标)
+    struct QuickenSlot
+    {
+        std::uint8_t warmup = 0; // 同一特化形式连续命中次数
+        std::uint8_t deopts = 0; // 守卫失败 (退回泛型) 次数，阈值随之倍增
+        std::uint8_t lastOp = 0; // 上次观测到的特化形式 (OpCode)
+    };
+
+    // 调用点内联缓存 (按 pc 下标)：Call / TailCall 上次调用的闭包；弱引用，闭包死去后由 GC 清空
+    struct CallSiteCache
+    {
+        std::uint64_t   calleeBits = ~std::uint64_t(0); // 闭包 Value 的原始位；初值不是任何合法 Value
+        FunctionObject *callee     = nullptr;
+        Proto          *proto      = nullptr;
+    };
+
+    // 字段访问内联缓存 (按 pc 下标)：GetFieldK / SetFieldK 上次接收者的结构体与解析出的槽位；
+    // GetField / SetField 处为编译器预置的期望结构体与槽位，运行时不改写
+    struct FieldSiteCache
+    {
+        StructObject *klass = nullptr; // 结构体由编译器常驻分配，不会被回收或搬动，无需作为 GC 根
+        std::uint8_t  slot  = 0;
     };
 
     struct Proto
@@ -101,11 +248,49 @@ namespace Fig
         DynArray<UpvalueInfo> upvalues;
         uint8_t               maxRegisters = 0;
         uint8_t               numParams    = 0;
+
+        // 基线 JIT：调用 + 回边计数，达到阈值后编译 (VM 持有机器码)
+        std::uint32_t  hotCount = 0;
+        Jit::JitCode  *jitCode  = nullptr;
+
+        // 运行时特化计数，VM::Execute 按 code.size() 分配
+        DynArray<QuickenSlot> quicken;
+
+        // 调用点内联缓存，含 Call / TailCall 时由 VM::Execute 按 code.size() 分配
+        DynArray<CallSiteCache> callCache;
+
+        // 字段访问内联缓存：含 GetField / SetField 时由编译器分配并预置，否则含 GetFieldK / SetFieldK 时由 VM::Execute 按 code.size() 分配
+        DynArray<FieldSiteCache> fieldCache;
+
+        // 追踪 JIT：首次回边时按 code.size() 分配
+        DynArray<LoopAnchor> loopAnchors;
+
+        // 寄存器活跃位图 (Liveness.cpp)：安全点按 pc 升序，每个安全点 liveWords 个字
+        DynArray<std::uint32_t> safepoints;
+        DynArray<std::uint64_t> liveMaps;
+        std::uint8_t            liveWords = 0;
+
+        // pc 处的活跃位图，不是安全点返回 nullptr
+        const std::uint64_t *LiveMapAt(std::uint32_t pc) const
+        {
+            auto it = std::lower_bound(safepoints.begin(), safepoints.end(), pc);
+            if (it == safepoints.end() || *it != pc)
+                return nullptr;
+            return liveMaps.data() + (it - safepoints.begin()) * liveWords;
+        }
     };
 
     struct CompiledModule
     {
         DynArray<Proto *> protos;
+        std::uint32_t     globalCount = 0; // 全局槽位数，VM 据此分配 globals
+
+        // 字符串字面量常量 (Compiler 分配)，不进入 VM 的 GC 链表
+        DynArray<StringObject *> strings;
+        // 超出 Int 范围的整数常量，同样常驻
+        DynArray<BigIntObject *> bigInts;
+        // 结构体 (Compiler 按 StructType 分配)，同样常驻
+        DynArray<StructObject *> structs;
     };
 
 } // namespace Fig
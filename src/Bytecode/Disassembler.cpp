@@ -10,6 +10,46 @@
 
 namespace Fig
 {
+    namespace
+    {
+        // 最后一个操作数是 int8 立即数
+        bool hasImmOperand(OpCode op)
+        {
+            switch (op)
+            {
+                case OpCode::AddI:
+                case OpCode::SubI:
+                case OpCode::MulI:
+                case OpCode::EqualI:
+                case OpCode::NotEqualI:
+                case OpCode::GreaterI:
+                case OpCode::LessI:
+                case OpCode::GreaterEqualI:
+                case OpCode::LessEqualI: return true;
+                default: return op >= OpCode::JmpIfNotEqualI && op <= OpCode::JmpIfNotLessEqualI;
+            }
+        }
+
+        // 最后一个操作数是常量池下标
+        bool hasConstOperand(OpCode op)
+        {
+            switch (op)
+            {
+                case OpCode::AddK:
+                case OpCode::SubK:
+                case OpCode::MulK:
+                case OpCode::EqualK:
+                case OpCode::NotEqualK:
+                case OpCode::GreaterK:
+                case OpCode::LessK:
+                case OpCode::GreaterEqualK:
+                case OpCode::LessEqualK:
+                case OpCode::GetFieldK: return true;
+                default: return op >= OpCode::JmpIfNotEqualK && op <= OpCode::JmpIfNotLessEqualK;
+            }
+        }
+    } // namespace
+
     void Disassembler::DisassembleModule(const CompiledModule *module, std::ostream &stream)
     {
         if (!module) return;
@@ -41,6 +81,19 @@ namespace Fig
                 uint8_t b = (inst >> 16) & 0xFF;
                 uint8_t c = (inst >> 24) & 0xFF;
                 stream << std::format("A:{:<3} B:{:<3} C:{:<3}", a, b, c);
+
+                if (hasImmOperand(op))
+                {
+                    stream << std::format(" ; {}", static_cast<int8_t>(c));
+                }
+                else if (hasConstOperand(op) && c < proto->constants.size())
+                {
+                    stream << std::format(" ; {}", proto->constants[c].ToString());
+                }
+                else if (op == OpCode::SetFieldK && b < proto->constants.size())
+                {
+                    stream << std::format(" ; {}", proto->constants[b].ToString());
+                }
             }
             else if (fmt == Format::ABx)
             {
@@ -48,7 +101,7 @@ namespace Fig
                 stream << std::format("A:{:<3} Bx:{:<5}", a, bx);
                 
                 // 自动关联常量池
-                if (op == OpCode::LoadK && bx < proto->constants.size())
+                if ((op == OpCode::LoadK || op == OpCode::NewInstance) && bx < proto->constants.size())
                 {
                     stream << std::format(" ; {}", proto->constants[bx].ToString());
                 }
@@ -64,6 +117,21 @@ namespace Fig
                     stream << std::format(" ; to [{:04}]", i + sbx + 1);
                 }
             }
+            else if (fmt == Format::ABsC)
+            {
+                uint8_t b  = (inst >> 16) & 0xFF;
+                int8_t  sc = static_cast<int8_t>((inst >> 24) & 0xFF);
+                stream << std::format("A:{:<3} B:{:<3} sC:{:<4} ; to [{:04}]", a, b, sc, i + sc + 1);
+
+                if (hasImmOperand(op))
+                {
+                    stream << std::format(", {}", static_cast<int8_t>(b));
+                }
+                else if (hasConstOperand(op) && b < proto->constants.size())
+                {
+                    stream << std::format(", {}", proto->constants[b].ToString());
+                }
+            }
             stream << "\n";
         }
 
@@ -86,14 +154,41 @@ namespace Fig
             case OpCode::GetGlobal:
             case OpCode::SetGlobal:
             case OpCode::LoadFn:
+            case OpCode::LoadNative:
+            case OpCode::NewInstance:
                 return Format::ABx;
 
             case OpCode::Exit:
-            case OpCode::Exit_MaxRecursionDepthExceeded:
             case OpCode::Jmp:
             case OpCode::JmpIfFalse:
                 return Format::AsBx;
 
+            case OpCode::JmpIfNotLess:
+            case OpCode::JmpIfNotLessEqual:
+            case OpCode::JmpIfNotEqual:
+            case OpCode::JmpIfEqual:
+            case OpCode::IntJmpIfNotLess:
+            case OpCode::IntJmpIfNotLessEqual:
+            case OpCode::IntJmpIfNotEqual:
+            case OpCode::IntJmpIfEqual:
+            case OpCode::JmpIfNotLessInt:
+            case OpCode::JmpIfNotLessDouble:
+            case OpCode::JmpIfNotLessEqualInt:
+            case OpCode::JmpIfNotLessEqualDouble:
+            case OpCode::JmpIfNotEqualI:
+            case OpCode::JmpIfEqualI:
+            case OpCode::JmpIfNotGreaterI:
+            case OpCode::JmpIfNotLessI:
+            case OpCode::JmpIfNotGreaterEqualI:
+            case OpCode::JmpIfNotLessEqualI:
+            case OpCode::JmpIfNotEqualK:
+            case OpCode::JmpIfEqualK:
+            case OpCode::JmpIfNotGreaterK:
+            case OpCode::JmpIfNotLessK:
+            case OpCode::JmpIfNotGreaterEqualK:
+            case OpCode::JmpIfNotLessEqualK:
+                return Format::ABsC;
+
             default:
                 return Format::ABC;
         }
@@ -27,7 +27,8 @@ namespace Fig
         {
             ABC,
             ABx,
-            AsBx
+            AsBx,
+            ABsC
         };
 
         static Format GetFormat(OpCode op);
@@ -87,7 +87,11 @@ namespace Fig
         }
 
         emit(Op::iAsBx(OpCode::Exit, 0, 0), &program->nodes.back()->location);
+        peephole(bootProto, bootState);
+        seedFieldSites(bootProto, bootState);
+        computeLiveness(bootProto);
 
+        module->globalCount = static_cast<std::uint32_t>(globalIDMap.size());
         return module;
     }
 
@@ -134,9 +138,35 @@ namespace Fig
         return idx;
     }
 
+    int Compiler::peekConstant(Value val) const
+    {
+        if (auto it = current->constantMap.find(val); it != current->constantMap.end())
+            return it->second;
+        return static_cast<int>(current->proto->constants.size());
+    }
+
     void Compiler::emit(Instruction inst, SourceLocation *loc)
     {
         current->proto->code.push_back(inst);
         current->proto->locations.push_back(loc);
     }
+
+    void Compiler::seedFieldSites(Proto *proto, const FuncState &fs)
+    {
+        if (fs.staticFieldSites.empty())
+            return;
+        proto->fieldCache.resize(proto->code.size());
+        for (const auto &[pc, site] : fs.staticFieldSites)
+            proto->fieldCache[pc] = site;
+    }
+
+    int Compiler::emitCondJump(Register cond, Register mark, SourceLocation *loc)
+    {
+        int idx = static_cast<int>(current->proto->code.size());
+        emit(Op::iAsBx(OpCode::JmpIfFalse, cond, 0), loc);
+        // 条件是具名局部变量时，Cmp 写的是变量本身，融合会吞掉这次写入
+        if (cond >= mark)
+            current->tempCondJumps.push_back(idx);
+        return idx;
+    }
 } // namespace Fig
@@ -10,6 +10,8 @@
 #include <Error/Diagnostics.hpp>
 #include <Object/Object.hpp>
 
+#include <optional>
+
 namespace Fig
 {
     using Register = std::uint8_t;
@@ -26,6 +28,10 @@ namespace Fig
             Register  freereg;
             FuncState *enclosing;
             HashMap<Value, int> constantMap;
+            // 条件位于临时槽位 (水位线之上) 的 JmpIfFalse 下标，只有它们允许比较-跳转融合
+            DynArray<int> tempCondJumps;
+            // 静态字段站点 (GetField / SetField 的下标) 及其期望的结构体与槽位，收尾时预置到 Proto::fieldCache
+            DynArray<std::pair<int, FieldSiteCache>> staticFieldSites;
 
             FuncState(Proto *p, FuncState *e)
                 : proto(p), freereg(p->numParams), enclosing(e) {}
@@ -39,15 +45,53 @@ namespace Fig
         HashMap<String, int> globalIDMap;
         int getGlobalID(const String& name);
 
+        HashMap<String, StringObject *> stringPool;
+        Value internStringLiteral(const String &raw);
+        Value internString(const String &data);
+
+        // 结构体的运行时对象：按 StructType 惰性分配，常驻于 CompiledModule
+        HashMap<const StructType *, StructObject *> structPool;
+        Result<StructObject *, Error> structObjectFor(const StructType *st, const SourceLocation &loc);
+
+        // 字段名放进常量池，供 GetFieldK / SetFieldK 的 8 位操作数引用
+        Result<std::uint8_t, Error> fieldNameConstant(MemberExpr *m);
+        // 发射 GetField / SetField，并登记接收者静态类型对应的结构体 (VM 据此校验 klass)
+        Result<void, Error> emitStaticField(Instruction inst, MemberExpr *m, std::uint8_t slot);
+
+        // 整数常量：落在 Int 范围内为 Int，否则取常驻的 BigIntObject (按十进制文本去重，常量折叠可能多次求值同一子式)
+        HashMap<String, BigIntObject *> bigIntPool;
+        Value integerConstant(const BigInt &v);
+        Result<Value, Error> parsePhysicalNumber(const String &raw, const SourceLocation &loc);
+
         Result<Register, Error> allocateReg(const SourceLocation &loc);
         void                    freeReg(Register count = 1);
         int                     addConstant(Value val);
+        // addConstant(val) 将返回的下标，但不登记；先确认下标放得进操作数再真正加入常量池
+        int                     peekConstant(Value val) const;
 
         void emit(Instruction inst, SourceLocation *loc);
 
         Result<void, Error>     compileStmt(Stmt *stmt);
         Result<Register, Error> compileExpr(Expr *expr, Register target = NO_REG);
 
+        // 参数连续装填到 freereg 起的滑窗，返回滑窗基址
+        Result<Register, Error> compileCallArgs(CallExpr *call);
+        // return f(...)：参数下移到 registerBase 并复用当前 CallFrame
+        Result<void, Error> compileTailCall(CallExpr *call);
+
+        // 编译期常量求值：数字字面量及其 + - * 与取负组合，非常量返回 nullopt
+        std::optional<Value> evalConstant(Expr *expr);
+
+        // 发射条件跳转 JmpIfFalse cond；cond 不低于水位线 mark 时登记为可融合
+        int emitCondJump(Register cond, Register mark, SourceLocation *loc);
+
+        // 发射后窥孔优化 (Peephole.cpp)：比较-跳转融合，并重定位跳转偏移、locations 与静态字段站点
+        void peephole(Proto *proto, FuncState &fs);
+        // 按最终下标把静态字段站点写进 Proto::fieldCache
+        void seedFieldSites(Proto *proto, const FuncState &fs);
+        // 寄存器活跃分析 (Liveness.cpp)：在最终代码上为安全点生成活跃位图
+        void computeLiveness(Proto *proto);
+
     public:
         Compiler(SourceManager &m, Diagnostics &d) : manager(m), diag(d) {}
         Result<CompiledModule *, Error> Compile(Program *program);
@@ -7,70 +7,428 @@
 #include <Ast/Expr/IdentiExpr.hpp>
 #include <Ast/Expr/InfixExpr.hpp>
 #include <Ast/Expr/LiteralExpr.hpp>
+#include <Ast/Expr/MemberExpr.hpp>
+#include <Ast/Expr/ObjectInitExpr.hpp>
+#include <Ast/Expr/PrefixExpr.hpp>
 #include <Compiler/Compiler.hpp>
 #include <charconv>
 #include <limits>
+#include <new>
+#include <string>
+#include <string_view>
 #include <system_error>
 
 
 namespace Fig
 {
-    static Result<Value, Error> parsePhysicalNumber(const String &raw, const SourceLocation &loc)
+    Value Compiler::integerConstant(const BigInt &v)
     {
-        char buffer[128];
-        int  j       = 0;
-        bool isFloat = false;
-        for (size_t i = 0; i < raw.length() && j < 127; ++i)
+        std::int64_t small;
+        if (v.ToInt64(small) && Value::FitsInt(small))
+            return Value::FromInt(small);
+
+        String key = v.ToString();
+        if (auto it = bigIntPool.find(key); it != bigIntPool.end())
+            return Value::FromObject(it->second);
+
+        auto  limbs = v.Limbs();
+        void *mem   = ::operator new(sizeof(BigIntObject) + limbs.size() * sizeof(BigInt::Limb));
+        auto *big   = new (mem) BigIntObject;
+        big->next     = nullptr;
+        big->color    = GCColor::Black;
+        big->klass    = nullptr;
+        big->type     = ObjectType::BigInt;
+        big->negative = v.IsNegative();
+        big->size     = static_cast<std::uint32_t>(limbs.size());
+        std::copy(limbs.begin(), limbs.end(), big->limbs);
+        module->bigInts.push_back(big);
+        bigIntPool[key] = big;
+        return Value::FromObject(big);
+    }
+
+    Result<Value, Error> Compiler::parsePhysicalNumber(const String &raw, const SourceLocation &loc)
+    {
+        std::string digits;
+        bool        isFloat = false;
+        for (size_t i = 0; i < raw.length(); ++i)
         {
             char32_t c = raw[i];
             if (c == '_')
                 continue;
             if (c == '.' || c == 'e' || c == 'E')
                 isFloat = true;
-            buffer[j++] = (char) c;
+            digits.push_back(static_cast<char>(c));
         }
-        buffer[j] = '\0';
+        const char *end = digits.data() + digits.size();
 
         if (isFloat)
         {
             double dVal;
-            auto [ptr, ec] = std::from_chars(buffer, buffer + j, dVal);
+            auto [ptr, ec] = std::from_chars(digits.data(), end, dVal);
             if (ec != std::errc())
                 return std::unexpected(Error(ErrorType::SyntaxError, "float overflow", "", loc));
             return Value::FromDouble(dVal);
         }
-        else
+
+        int         base  = 10;
+        const char *start = digits.data();
+        if (digits.size() > 2 && digits[0] == '0')
         {
-            int         base  = 10;
-            const char *start = buffer;
-            if (j > 2 && buffer[0] == '0')
+            if (digits[1] == 'x' || digits[1] == 'X')
+            {
+                base = 16;
+                start += 2;
+            }
+            else if (digits[1] == 'b' || digits[1] == 'B')
             {
-                if (buffer[1] == 'x' || buffer[1] == 'X')
+                base = 2;
+                start += 2;
+            }
+        }
+
+        int64_t iVal;
+        auto [ptr, ec] = std::from_chars(start, end, iVal, base);
+        if (ec == std::errc() && Value::FitsInt(iVal))
+            return Value::FromInt(iVal);
+
+        // 超出 Int 范围：按任意精度解析
+        auto big = BigInt::Parse(std::string_view(start, end), base);
+        if (!big)
+            return std::unexpected(Error(ErrorType::SyntaxError, "invalid integer literal", "", loc));
+        return integerConstant(*big);
+    }
+
+    static bool isIntegralConstant(Value v)
+    {
+        return v.IsInt() || IsBigInt(v);
+    }
+
+    static BigInt constantBigInt(Value v)
+    {
+        return v.IsInt() ? BigInt::FromInt(v.AsInt()) : AsBigInt(v)->ToBigInt();
+    }
+
+    static double asNumber(Value v)
+    {
+        if (v.IsInt())
+            return static_cast<double>(v.AsInt());
+        if (IsBigInt(v))
+            return AsBigInt(v)->ToBigInt().ToDouble();
+        return v.AsDouble();
+    }
+
+    std::optional<Value> Compiler::evalConstant(Expr *expr)
+    {
+        switch (expr->type)
+        {
+            case AstType::LiteralExpr: {
+                const Token &tok = static_cast<LiteralExpr *>(expr)->literal;
+                if (tok.type != TokenType::LiteralNumber)
+                    return std::nullopt;
+                auto vRes = parsePhysicalNumber(manager.GetSub(tok.index, tok.length), expr->location);
+                if (!vRes)
+                    return std::nullopt; // 错误留给 LiteralExpr 正常路径报告
+                return *vRes;
+            }
+
+            case AstType::PrefixExpr: {
+                auto *p = static_cast<PrefixExpr *>(expr);
+                if (p->op != UnaryOperator::Negate)
+                    return std::nullopt;
+                auto v = evalConstant(p->operand);
+                if (!v)
+                    return std::nullopt;
+                if (v->IsInt() && Value::FitsInt(-v->AsInt()))
+                    return Value::FromInt(-v->AsInt());
+                if (isIntegralConstant(*v))
+                    return integerConstant(-constantBigInt(*v));
+                return Value::FromDouble(-v->AsDouble());
+            }
+
+            case AstType::InfixExpr: {
+                auto *in = static_cast<InfixExpr *>(expr);
+                if (in->op != BinaryOperator::Add && in->op != BinaryOperator::Subtract
+                    && in->op != BinaryOperator::Multiply)
+                    return std::nullopt;
+
+                auto l = evalConstant(in->left);
+                if (!l)
+                    return std::nullopt;
+                auto r = evalConstant(in->right);
+                if (!r)
+                    return std::nullopt;
+
+                // 与运行时一致：Int 运算溢出 48 位时按 BigInt 计算
+                if (l->IsInt() && r->IsInt())
                 {
-                    base = 16;
-                    start += 2;
+                    std::int64_t a = l->AsInt(), b = r->AsInt(), out;
+                    bool         ok;
+                    switch (in->op)
+                    {
+                        case BinaryOperator::Add: ok = Value::CheckedAdd(a, b, out); break;
+                        case BinaryOperator::Subtract: ok = Value::CheckedSub(a, b, out); break;
+                        default: ok = Value::CheckedMul(a, b, out); break;
+                    }
+                    if (ok)
+                        return Value::FromInt(out);
                 }
-                else if (buffer[1] == 'b' || buffer[1] == 'B')
+                if (isIntegralConstant(*l) && isIntegralConstant(*r))
                 {
-                    base = 2;
-                    start += 2;
+                    BigInt a = constantBigInt(*l), b = constantBigInt(*r);
+                    switch (in->op)
+                    {
+                        case BinaryOperator::Add: return integerConstant(a + b);
+                        case BinaryOperator::Subtract: return integerConstant(a - b);
+                        default: return integerConstant(a * b);
+                    }
+                }
+
+                double a = asNumber(*l), b = asNumber(*r);
+                switch (in->op)
+                {
+                    case BinaryOperator::Add: return Value::FromDouble(a + b);
+                    case BinaryOperator::Subtract: return Value::FromDouble(a - b);
+                    default: return Value::FromDouble(a * b);
                 }
             }
-            int64_t iVal;
-            auto [ptr, ec] = std::from_chars(start, buffer + j, iVal, base);
-            if (ec != std::errc())
-                return std::unexpected(Error(ErrorType::SyntaxError, "integer overflow", "", loc));
 
-            if (iVal >= std::numeric_limits<int32_t>::min()
-                && iVal <= std::numeric_limits<int32_t>::max())
+            default: return std::nullopt;
+        }
+    }
+
+    // 常量操作数在右侧时可用的 I / K 形式；返回 false 表示该运算符没有此形式
+    static bool constantFormOf(BinaryOperator op, bool isImm, OpCode &out)
+    {
+        switch (op)
+        {
+            case BinaryOperator::Add: out = isImm ? OpCode::AddI : OpCode::AddK; return true;
+            case BinaryOperator::Subtract: out = isImm ? OpCode::SubI : OpCode::SubK; return true;
+            case BinaryOperator::Multiply: out = isImm ? OpCode::MulI : OpCode::MulK; return true;
+            case BinaryOperator::Equal: out = isImm ? OpCode::EqualI : OpCode::EqualK; return true;
+            case BinaryOperator::NotEqual:
+                out = isImm ? OpCode::NotEqualI : OpCode::NotEqualK;
+                return true;
+            case BinaryOperator::Greater:
+                out = isImm ? OpCode::GreaterI : OpCode::GreaterK;
+                return true;
+            case BinaryOperator::Less: out = isImm ? OpCode::LessI : OpCode::LessK; return true;
+            case BinaryOperator::GreaterEqual:
+                out = isImm ? OpCode::GreaterEqualI : OpCode::GreaterEqualK;
+                return true;
+            case BinaryOperator::LessEqual:
+                out = isImm ? OpCode::LessEqualI : OpCode::LessEqualK;
+                return true;
+            default: return false;
+        }
+    }
+
+    // 常量在左侧时交换操作数后的等价运算符 (3 < x  ==>  x > 3)
+    static bool mirroredOf(BinaryOperator op, BinaryOperator &out)
+    {
+        switch (op)
+        {
+            case BinaryOperator::Add:
+            case BinaryOperator::Multiply:
+            case BinaryOperator::Equal:
+            case BinaryOperator::NotEqual: out = op; return true;
+            case BinaryOperator::Less: out = BinaryOperator::Greater; return true;
+            case BinaryOperator::Greater: out = BinaryOperator::Less; return true;
+            case BinaryOperator::LessEqual: out = BinaryOperator::GreaterEqual; return true;
+            case BinaryOperator::GreaterEqual: out = BinaryOperator::LessEqual; return true;
+            default: return false;
+        }
+    }
+
+    // callee 是 import 的标准库成员时返回原生函数编号，否则 -1
+    static int nativeIdOf(Expr *callee)
+    {
+        if (callee->type != AstType::MemberExpr)
+            return -1;
+        return static_cast<MemberExpr *>(callee)->nativeId;
+    }
+
+    // 顶层 func 定义 (其 Symbol::index 是 proto 下标)；全局变量即使存放函数也只能走动态 Call
+    static bool isGlobalFunction(Expr *callee)
+    {
+        if (callee->type != AstType::IdentiExpr)
+            return false;
+        Symbol *sym = static_cast<IdentiExpr *>(callee)->resolvedSymbol;
+        return sym->location == SymbolLocation::Global && sym->isConst;
+    }
+
+    /*
+        字符串字面量 => 常量池中的 StringObject。
+        去掉引号并处理转义；同一模块内相同内容共用一个对象。
+        这些对象归 CompiledModule 所有，不进入 VM 的 GC 堆，恒为 Black，标记时直接跳过
+    */
+    Value Compiler::internStringLiteral(const String &raw)
+    {
+        String data;
+        for (std::size_t i = 1; i + 1 < raw.length(); ++i)
+        {
+            char32_t ch = raw[i];
+            if (ch == U'\\' && i + 2 < raw.length())
             {
-                return Value::FromInt(static_cast<int32_t>(iVal));
+                switch (raw[++i])
+                {
+                    case U'n': ch = U'\n'; break;
+                    case U't': ch = U'\t'; break;
+                    case U'r': ch = U'\r'; break;
+                    case U'0': ch = U'\0'; break;
+                    default: ch = raw[i]; break; // \\ \" \'
+                }
             }
-            else
+            data.push_back(ch);
+        }
+        return internString(data);
+    }
+
+    Value Compiler::internString(const String &data)
+    {
+        if (auto it = stringPool.find(data); it != stringPool.end())
+            return Value::FromObject(it->second);
+
+        auto *str     = new StringObject();
+        str->next     = nullptr;
+        str->color    = GCColor::Black;
+        str->klass    = nullptr;
+        str->type     = ObjectType::String;
+        str->data     = data;
+        str->hash     = StringHash(data);
+        str->interned = false; // 执行时由 VM 登记进驻留表
+        module->strings.push_back(str);
+        stringPool[data] = str;
+        return Value::FromObject(str);
+    }
+
+    // 接收者的结构体静态已知时返回字段槽位 (GetField / SetField)，否则按名字访问
+    static std::optional<std::uint8_t> staticFieldSlot(MemberExpr *m)
+    {
+        const Type &t = m->target->resolvedType;
+        if (!t.is(TypeTag::Struct))
+            return std::nullopt;
+        auto *st = static_cast<StructType *>(t.base);
+        auto  it = st->fieldMap.find(m->name);
+        if (it == st->fieldMap.end() || it->second > std::numeric_limits<std::uint8_t>::max())
+            return std::nullopt;
+        return static_cast<std::uint8_t>(it->second);
+    }
+
+    Result<std::uint8_t, Error> Compiler::fieldNameConstant(MemberExpr *m)
+    {
+        int kIdx = addConstant(internString(m->name));
+        if (kIdx > std::numeric_limits<std::uint8_t>::max())
+            return std::unexpected(Error(ErrorType::InternalError,
+                "too many constants for field access",
+                "split the function",
+                m->location));
+        return static_cast<std::uint8_t>(kIdx);
+    }
+
+    Result<void, Error> Compiler::emitStaticField(Instruction inst, MemberExpr *m, std::uint8_t slot)
+    {
+        auto klass = structObjectFor(static_cast<StructType *>(m->target->resolvedType.base), m->location);
+        if (!klass)
+            return std::unexpected(klass.error());
+        current->staticFieldSites.push_back(
+            {static_cast<int>(current->proto->code.size()), FieldSiteCache{*klass, slot}});
+        emit(inst, &m->location);
+        return {};
+    }
+
+    Result<StructObject *, Error> Compiler::structObjectFor(const StructType *st, const SourceLocation &loc)
+    {
+        if (auto it = structPool.find(st); it != structPool.end())
+            return it->second;
+
+        if (st->fields.size() > std::numeric_limits<std::uint8_t>::max())
+            return std::unexpected(Error(ErrorType::TypeError,
+                "struct '" + st->name + "' has too many fields",
+                "at most 255 fields per struct",
+                loc));
+
+        auto *klass       = new StructObject();
+        klass->next       = nullptr;
+        klass->color      = GCColor::Black;
+        klass->klass      = nullptr;
+        klass->type       = ObjectType::Struct;
+        klass->name       = st->name;
+        klass->fieldCount = static_cast<std::uint8_t>(st->fields.size());
+        for (const auto &f : st->fields)
+            klass->fieldNames.push_back(f.name);
+        module->structs.push_back(klass);
+        structPool[st] = klass;
+        return klass;
+    }
+
+    Result<Register, Error> Compiler::compileCallArgs(CallExpr *c)
+    {
+        Register baseReg = current->freereg;
+
+        // 连续装填参数，占据 baseReg, baseReg+1, baseReg+2...
+        for (auto *arg : c->args.args)
+        {
+            auto allocRes = allocateReg(arg->location);
+            if (!allocRes)
+            {
+                return allocRes;
+            }
+
+            Register argTarget = *allocRes;
+            auto     res       = compileExpr(arg, argTarget);
+            if (!res)
+                return std::unexpected(res.error());
+        }
+        return baseReg;
+    }
+
+    /*
+        return f(a, b)  ==>  TailFastCall / TailCall
+
+        参数仍按普通调用装填到 baseReg 起的滑窗，VM 关闭 upvalue 后把它们
+        下移到 registerBase[0..argc)，原地替换 CallFrame 的 proto / ip。
+        callee 的 Return 写回 registerBase[0]，正好是原调用方等待的槽位，
+        因此无需额外的 Return 指令。
+    */
+    Result<void, Error> Compiler::compileTailCall(CallExpr *c)
+    {
+        Register mark = current->freereg;
+
+        auto argsRes = compileCallArgs(c);
+        if (!argsRes)
+            return std::unexpected(argsRes.error());
+        Register baseReg = *argsRes;
+        auto     argc    = static_cast<uint8_t>(c->args.args.size());
+
+        // 原生函数不占帧，无需尾调用：调用后直接 Return 结果
+        if (int nativeId = nativeIdOf(c->callee); nativeId >= 0)
+        {
+            if (argc == 0)
             {
-                return Value::FromDouble(static_cast<double>(iVal));
+                auto res = allocateReg(c->location);
+                if (!res)
+                    return std::unexpected(res.error());
             }
+            emit(Op::iABC(OpCode::CallNative, static_cast<uint8_t>(nativeId), baseReg, argc),
+                &c->location);
+            emit(Op::iABC(OpCode::Return, baseReg, 0, 0), &c->location);
+        }
+        else if (isGlobalFunction(c->callee))
+        {
+            int protoIdx = static_cast<IdentiExpr *>(c->callee)->resolvedSymbol->index;
+            emit(Op::iABC(OpCode::TailFastCall, static_cast<uint8_t>(protoIdx), baseReg, argc),
+                &c->location);
+        }
+        else
+        {
+            auto r_fn = compileExpr(c->callee);
+            if (!r_fn)
+                return std::unexpected(r_fn.error());
+            emit(Op::iABC(OpCode::TailCall, *r_fn, baseReg, argc), &c->location);
         }
+
+        current->freereg = mark;
+        return {};
     }
 
     Result<Register, Error> Compiler::compileExpr(Expr *expr, Register target)
@@ -81,6 +439,24 @@ namespace Fig
                 Error(ErrorType::InternalError, "null expr in compiler", "", {}));
         }
 
+        // 常量折叠：整棵子树都是数字常量时直接 LoadK
+        if (expr->type == AstType::InfixExpr || expr->type == AstType::PrefixExpr)
+        {
+            if (auto folded = evalConstant(expr))
+            {
+                Register r = target;
+                if (r == NO_REG)
+                {
+                    auto res = allocateReg(expr->location);
+                    if (!res)
+                        return std::unexpected(res.error());
+                    r = *res;
+                }
+                emit(Op::iABx(OpCode::LoadK, r, static_cast<uint16_t>(addConstant(*folded))), &expr->location);
+                return r;
+            }
+        }
+
         switch (expr->type)
         {
             case AstType::LiteralExpr: {
@@ -98,7 +474,8 @@ namespace Fig
                 }
                 else if (tok.type == TokenType::LiteralString)
                 {
-                    int kIdx = addConstant(Value::GetNullInstance()); // TODO: String 支持
+                    Value str  = internStringLiteral(manager.GetSub(tok.index, tok.length));
+                    int   kIdx = addConstant(str);
                     emit(Op::iABx(OpCode::LoadK, r, static_cast<uint16_t>(kIdx)), &l->location);
                 }
                 else if (tok.type == TokenType::LiteralNull)
@@ -137,7 +514,9 @@ namespace Fig
                 Register r = (target == NO_REG) ? *allocateReg(i->location) : target;
                 if (sym->location == SymbolLocation::Upvalue)
                 {
-                    emit(Op::iABC(OpCode::GetUpval, r, static_cast<uint8_t>(sym->index), 0), &i->location);
+                    OpCode op = current->proto->upvalues[sym->index].byValue ? OpCode::GetCapture
+                                                                             : OpCode::GetUpval;
+                    emit(Op::iABC(op, r, static_cast<uint8_t>(sym->index), 0), &i->location);
                 }
                 else if (sym->location == SymbolLocation::Global)
                 {
@@ -147,35 +526,144 @@ namespace Fig
                 return r;
             }
 
-            case AstType::CallExpr: {
-                auto    *c       = static_cast<CallExpr *>(expr);
-                Register mark    = current->freereg; // 记录调用前的栈顶水位
-                Register baseReg = current->freereg; // 锁定滑窗基址
+            case AstType::MemberExpr: {
+                auto *m = static_cast<MemberExpr *>(expr);
+                if (m->nativeId >= 0)
+                {
+                    Register r = (target == NO_REG) ? *allocateReg(m->location) : target;
+                    emit(Op::iABx(OpCode::LoadNative, r, static_cast<uint16_t>(m->nativeId)), &m->location);
+                    return r;
+                }
 
-                // 连续装填参数，占据 baseReg, baseReg+1, baseReg+2...
-                for (auto *arg : c->args.args)
+                Register mark  = current->freereg;
+                auto     r_obj = compileExpr(m->target);
+                if (!r_obj)
+                    return r_obj;
+                current->freereg = mark; // 接收者的临时槽位可直接存放结果
+
+                Register r_d;
+                if (target == NO_REG)
                 {
-                    auto allocRes = allocateReg(arg->location);
-                    if (!allocRes)
-                    {
-                        return allocRes;
-                    }
+                    auto res = allocateReg(m->location);
+                    if (!res)
+                        return std::unexpected(res.error());
+                    r_d = *res;
+                }
+                else
+                {
+                    r_d = target;
+                }
 
-                    Register argTarget = *allocRes;
-                    auto     res       = compileExpr(arg, argTarget);
+                if (auto slot = staticFieldSlot(m))
+                {
+                    if (auto r = emitStaticField(Op::iABC(OpCode::GetField, r_d, *r_obj, *slot), m, *slot); !r)
+                        return std::unexpected(r.error());
+                }
+                else
+                {
+                    auto kIdx = fieldNameConstant(m);
+                    if (!kIdx)
+                        return std::unexpected(kIdx.error());
+                    emit(Op::iABC(OpCode::GetFieldK, r_d, *r_obj, *kIdx), &m->location);
+                }
+                return r_d;
+            }
+
+            /*
+                new T{...}  ==>  字段值按槽位装填到 freereg 起的连续窗口，再一条 NewInstance。
+                具名 / 简写参数的槽位由 Analyzer 解析，求值仍按源码顺序；没给的字段为 null
+            */
+            case AstType::ObjectInitExpr: {
+                auto *o     = static_cast<ObjectInitExpr *>(expr);
+                auto  klass = structObjectFor(static_cast<StructType *>(o->resolvedType.base), o->location);
+                if (!klass)
+                    return std::unexpected(klass.error());
+
+                Register mark       = current->freereg;
+                Register baseReg    = current->freereg;
+                int      fieldCount = (*klass)->fieldCount;
+                for (int i = 0; i < std::max(fieldCount, 1); ++i) // 无字段时也要占住结果槽位
+                {
+                    auto res = allocateReg(o->location);
                     if (!res)
                         return std::unexpected(res.error());
                 }
 
-                bool isGlobalFastCall = false;
-                if (c->callee->type == AstType::IdentiExpr)
+                DynArray<bool> filled(fieldCount, false);
+                for (auto &arg : o->args)
+                {
+                    auto slot = static_cast<Register>(baseReg + arg.fieldIndex);
+                    auto res  = compileExpr(arg.value, slot);
+                    if (!res)
+                        return res;
+                    filled[arg.fieldIndex] = true;
+                }
+                for (int i = 0; i < fieldCount; ++i)
+                {
+                    if (!filled[i])
+                        emit(Op::iABC(OpCode::LoadNull, static_cast<Register>(baseReg + i), 0, 0), &o->location);
+                }
+
+                int kIdx = addConstant(Value::FromObject(*klass));
+                emit(Op::iABx(OpCode::NewInstance, baseReg, static_cast<uint16_t>(kIdx)), &o->location);
+
+                current->freereg = mark;
+
+                Register r_dest;
+                if (target == NO_REG)
+                {
+                    auto res = allocateReg(o->location);
+                    if (!res)
+                        return std::unexpected(res.error());
+                    r_dest = *res;
+                }
+                else
+                {
+                    r_dest = target;
+                }
+
+                if (r_dest != baseReg)
+                {
+                    emit(Op::iABx(OpCode::Mov, r_dest, baseReg), &o->location);
+                }
+                return r_dest;
+            }
+
+            case AstType::CallExpr: {
+                auto    *c    = static_cast<CallExpr *>(expr);
+                Register mark = current->freereg; // 记录调用前的栈顶水位
+
+                auto argsRes = compileCallArgs(c);
+                if (!argsRes)
+                    return argsRes;
+                Register baseReg = *argsRes; // 锁定滑窗基址
+
+                // 标准库原生函数与全局函数都按编号直接调用，不经过寄存器中的函数对象
+                bool isDirectCall = false;
+                if (int nativeId = nativeIdOf(c->callee); nativeId >= 0)
+                {
+                    isDirectCall = true;
+                    // 无参时也要保证 baseReg 在帧内：结果写回 R[baseReg]
+                    if (c->args.args.empty())
+                    {
+                        auto res = allocateReg(c->location);
+                        if (!res)
+                            return std::unexpected(res.error());
+                    }
+                    emit(Op::iABC(OpCode::CallNative,
+                             static_cast<uint8_t>(nativeId),
+                             baseReg,
+                             static_cast<uint8_t>(c->args.args.size())),
+                        &c->location);
+                }
+                else if (c->callee->type == AstType::IdentiExpr)
                 {
                     auto *id = static_cast<IdentiExpr *>(c->callee);
                     // 只有在全局区的函数，才能使用 FastCall
-                    if (id->resolvedSymbol->location == SymbolLocation::Global)
+                    if (isGlobalFunction(id))
                     {
-                        isGlobalFastCall = true;
-                        int protoIdx     = id->resolvedSymbol->index;
+                        isDirectCall = true;
+                        int protoIdx = id->resolvedSymbol->index;
                         emit(Op::iABC(OpCode::FastCall,
                                  static_cast<uint8_t>(protoIdx),
                                  baseReg,
@@ -184,7 +672,7 @@ namespace Fig
                     }
                 }
 
-                if (!isGlobalFastCall)
+                if (!isDirectCall)
                 {
                     // 动态闭包调用
                     // 先获取闭包对象所在的物理寄存器
@@ -254,11 +742,93 @@ namespace Fig
                                 static_cast<uint16_t>(getGlobalID(lid->name))), &lid->location);
                         }
                     }
+                    else if (in->left->type == AstType::MemberExpr)
+                    {
+                        auto *m = static_cast<MemberExpr *>(in->left);
+                        if (m->nativeId >= 0)
+                            return std::unexpected(Error(ErrorType::TypeError,
+                                "cannot assign to module member",
+                                "none",
+                                m->location));
+
+                        Register mark  = current->freereg;
+                        auto     r_obj = compileExpr(m->target);
+                        if (!r_obj)
+                            return r_obj;
+
+                        if (auto slot = staticFieldSlot(m))
+                        {
+                            if (auto r = emitStaticField(
+                                    Op::iABC(OpCode::SetField, *r_obj, *slot, *r_val), m, *slot);
+                                !r)
+                                return std::unexpected(r.error());
+                        }
+                        else
+                        {
+                            auto kIdx = fieldNameConstant(m);
+                            if (!kIdx)
+                                return std::unexpected(kIdx.error());
+                            emit(Op::iABC(OpCode::SetFieldK, *r_obj, *kIdx, *r_val), &m->location);
+                        }
+                        current->freereg = mark;
+                    }
                     return r_val;
                 }
 
                 Register mark = current->freereg; // 记录水位线
 
+                // 一侧为常量: 常量直接编码进指令 (int8 立即数或常量池下标)，省掉 LoadK 与一个临时槽位
+                {
+                    Expr          *varSide = in->left;
+                    BinaryOperator bop     = in->op;
+                    auto           k       = evalConstant(in->right);
+                    if (!k && mirroredOf(in->op, bop))
+                    {
+                        k       = evalConstant(in->left);
+                        varSide = in->right;
+                    }
+                    else
+                    {
+                        bop = in->op;
+                    }
+
+                    OpCode kop;
+                    bool   isImm = k && k->IsInt() && k->AsInt() >= std::numeric_limits<int8_t>::min()
+                                 && k->AsInt() <= std::numeric_limits<int8_t>::max();
+                    if (k && constantFormOf(bop, isImm, kop))
+                    {
+                        int operand = isImm ? static_cast<uint8_t>(static_cast<int8_t>(k->AsInt()))
+                                            : peekConstant(*k);
+                        if (operand <= std::numeric_limits<uint8_t>::max())
+                        {
+                            // 放得进 8 位才登记常量，否则走寄存器形式，由 LoadK 自行登记，不留死条目
+                            if (!isImm)
+                                addConstant(*k);
+                            auto r_v = compileExpr(varSide);
+                            if (!r_v)
+                                return std::unexpected(r_v.error());
+
+                            current->freereg = mark;
+
+                            Register r_d;
+                            if (target == NO_REG)
+                            {
+                                auto res = allocateReg(in->location);
+                                if (!res)
+                                    return std::unexpected(res.error());
+                                r_d = *res;
+                            }
+                            else
+                            {
+                                r_d = target;
+                            }
+
+                            emit(Op::iABC(kop, r_d, *r_v, static_cast<uint8_t>(operand)), &in->location);
+                            return r_d;
+                        }
+                    }
+                }
+
                 auto r_l = compileExpr(in->left);
                 if (!r_l)
                     return std::unexpected(r_l.error());
@@ -283,12 +853,22 @@ namespace Fig
                         break;
                     case BinaryOperator::Modulo: op = OpCode::Mod; break;
                     case BinaryOperator::BitXor: op = OpCode::BitXor; break;
-                    case BinaryOperator::Equal: op = OpCode::Equal; break;
-                    case BinaryOperator::NotEqual: op = OpCode::NotEqual; break;
-                    case BinaryOperator::Greater: op = OpCode::Greater; break;
-                    case BinaryOperator::Less: op = OpCode::Less; break;
-                    case BinaryOperator::GreaterEqual: op = OpCode::GreaterEqual; break;
-                    case BinaryOperator::LessEqual: op = OpCode::LessEqual; break;
+                    case BinaryOperator::Equal:
+                        op = isInt ? OpCode::IntFastEqual : OpCode::Equal;
+                        break;
+                    case BinaryOperator::NotEqual:
+                        op = isInt ? OpCode::IntFastNotEqual : OpCode::NotEqual;
+                        break;
+                    case BinaryOperator::Greater:
+                        op = isInt ? OpCode::IntFastGreater : OpCode::Greater;
+                        break;
+                    case BinaryOperator::Less: op = isInt ? OpCode::IntFastLess : OpCode::Less; break;
+                    case BinaryOperator::GreaterEqual:
+                        op = isInt ? OpCode::IntFastGreaterEqual : OpCode::GreaterEqual;
+                        break;
+                    case BinaryOperator::LessEqual:
+                        op = isInt ? OpCode::IntFastLessEqual : OpCode::LessEqual;
+                        break;
                     default:
                         return std::unexpected(Error(ErrorType::InternalError,
                             "unsupported binary operator",
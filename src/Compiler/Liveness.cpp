@@ -0,0 +1,278 @@
+/*!
+    @file src/Compiler/Liveness.cpp
+    @brief 寄存器活跃分析：为每个安全点生成活跃位图，GC 据此只扫描活跃槽位
+*/
+
+#include <Compiler/Compiler.hpp>
+
+#include <array>
+
+namespace Fig
+{
+    namespace
+    {
+        inline OpCode opOf(Instruction inst)
+        {
+            return static_cast<OpCode>(inst & 0xFF);
+        }
+        inline std::uint8_t aOf(Instruction inst)
+        {
+            return (inst >> 8) & 0xFF;
+        }
+        inline std::uint8_t bOf(Instruction inst)
+        {
+            return (inst >> 16) & 0xFF;
+        }
+        inline std::uint8_t cOf(Instruction inst)
+        {
+            return (inst >> 24) & 0xFF;
+        }
+        inline std::uint16_t bxOf(Instruction inst)
+        {
+            return (inst >> 16) & 0xFFFF;
+        }
+
+        struct RegSet
+        {
+            std::array<std::uint64_t, 4> words{}; // maxRegisters <= 255
+
+            void set(unsigned r)
+            {
+                words[r / 64] |= std::uint64_t{1} << (r % 64);
+            }
+            void clear(unsigned r)
+            {
+                words[r / 64] &= ~(std::uint64_t{1} << (r % 64));
+            }
+            void setRange(unsigned first, unsigned count)
+            {
+                for (unsigned r = first; r < first + count && r < 256; ++r)
+                    set(r);
+            }
+            // 返回是否有新增
+            bool merge(const RegSet &other)
+            {
+                bool grown = false;
+                for (std::size_t i = 0; i < words.size(); ++i)
+                {
+                    std::uint64_t next = words[i] | other.words[i];
+                    grown |= next != words[i];
+                    words[i] = next;
+                }
+                return grown;
+            }
+        };
+
+        constexpr int NO_TARGET = -1;
+
+        struct Effect
+        {
+            RegSet use;
+            int    def       = -1;        // 写入的寄存器
+            int    target    = NO_TARGET; // 跳转目标
+            bool   fallsThru = true;      // 是否会执行下一条
+            bool   safepoint = false;     // 可能触发 GC (分配或挂起在调用上)
+        };
+
+        /*
+            操作数布局见 Bytecode.hpp。quickening 只改写 opcode，
+            特化指令与泛型指令的操作数一致，位图在改写后依然有效
+        */
+        Effect effectOf(Instruction inst, int pc)
+        {
+            Effect e;
+            OpCode op = opOf(inst);
+            switch (op)
+            {
+                case OpCode::Exit: e.fallsThru = false; break;
+
+                case OpCode::LoadK:
+                case OpCode::LoadTrue:
+                case OpCode::LoadFalse:
+                case OpCode::LoadNull:
+                case OpCode::LoadNative:
+                case OpCode::GetGlobal:
+                case OpCode::GetUpval:
+                case OpCode::GetCapture: e.def = aOf(inst); break;
+
+                case OpCode::NewInstance:
+                    // 字段窗口的读取在 computeLiveness 中补上 (长度取自常量池里的结构体)
+                    e.def       = aOf(inst);
+                    e.safepoint = true;
+                    break;
+
+                case OpCode::LoadFn:
+                    // 捕获的槽位在 computeLiveness 中补上 (按值捕获是一次读取，按引用捕获始终活跃)
+                    e.def       = aOf(inst);
+                    e.safepoint = true;
+                    break;
+
+                case OpCode::SetGlobal:
+                case OpCode::SetUpval: e.use.set(aOf(inst)); break;
+
+                case OpCode::Call:
+                case OpCode::TailCall:
+                    e.use.set(aOf(inst));
+                    [[fallthrough]];
+                case OpCode::FastCall:
+                case OpCode::TailFastCall:
+                case OpCode::CallNative:
+                    e.use.setRange(bOf(inst), cOf(inst));
+                    e.safepoint = op != OpCode::TailFastCall;
+                    if (op == OpCode::TailCall || op == OpCode::TailFastCall)
+                        e.fallsThru = false;
+                    else
+                        e.def = bOf(inst);
+                    break;
+
+                case OpCode::Return:
+                    e.use.set(aOf(inst));
+                    e.fallsThru = false;
+                    break;
+
+                case OpCode::Jmp:
+                    e.target    = pc + static_cast<std::int16_t>(inst >> 16) + 1;
+                    e.fallsThru = false;
+                    break;
+
+                case OpCode::JmpIfFalse:
+                    e.use.set(aOf(inst));
+                    e.target = pc + static_cast<std::int16_t>(inst >> 16) + 1;
+                    break;
+
+                case OpCode::Mov:
+                    e.def = aOf(inst);
+                    e.use.set(bxOf(inst));
+                    break;
+
+                case OpCode::Copy:
+                case OpCode::GetField:
+                case OpCode::GetFieldK:
+                    e.def = aOf(inst);
+                    e.use.set(bOf(inst));
+                    break;
+
+                case OpCode::SetField:
+                case OpCode::SetFieldK:
+                    e.use.set(aOf(inst));
+                    e.use.set(cOf(inst));
+                    break;
+
+                default:
+                    if ((op >= OpCode::JmpIfNotLess && op <= OpCode::IntJmpIfEqual)
+                        || (op >= OpCode::JmpIfNotLessInt && op <= OpCode::JmpIfNotLessEqualDouble))
+                    {
+                        e.use.set(aOf(inst));
+                        e.use.set(bOf(inst));
+                        e.target = pc + static_cast<std::int8_t>(cOf(inst)) + 1;
+                    }
+                    else if (op >= OpCode::JmpIfNotEqualI && op <= OpCode::JmpIfNotLessEqualK)
+                    {
+                        e.use.set(aOf(inst));
+                        e.target = pc + static_cast<std::int8_t>(cOf(inst)) + 1;
+                    }
+                    else if (op >= OpCode::AddI && op <= OpCode::LessEqualK)
+                    {
+                        e.def = aOf(inst);
+                        e.use.set(bOf(inst));
+                    }
+                    else
+                    {
+                        // 三寄存器运算: A = R[B] op R[C]
+                        e.def = aOf(inst);
+                        e.use.set(bOf(inst));
+                        e.use.set(cOf(inst));
+                    }
+                    break;
+            }
+            return e;
+        }
+    } // namespace
+
+    /*
+        逆向数据流求每条指令的 liveOut，迭代到不动点。
+        安全点记录 liveIn ∪ liveOut：GC 可能发生在指令执行中途
+        (LoadFn 分配时尚未写 A，CallNative 分配时参数仍在使用)，
+        调用方帧挂起在 Call 上时返回后要读的寄存器都在 liveOut 里。
+
+        被 LoadFn 按引用捕获的寄存器在帧内始终活跃：open upvalue 直接指向该槽位，
+        内层闭包的读写不经过本帧的指令，分析看不到。按值捕获只是 LoadFn 处的一次读取
+    */
+    void Compiler::computeLiveness(Proto *proto)
+    {
+        const auto &code = proto->code;
+        int         n    = static_cast<int>(code.size());
+
+        proto->safepoints.clear();
+        proto->liveMaps.clear();
+        proto->liveWords = static_cast<std::uint8_t>((proto->maxRegisters + 63) / 64);
+        if (n == 0)
+            return;
+
+        DynArray<Effect> effects;
+        effects.reserve(n);
+        RegSet captured;
+        for (int pc = 0; pc < n; ++pc)
+        {
+            effects.push_back(effectOf(code[pc], pc));
+            if (opOf(code[pc]) == OpCode::NewInstance)
+            {
+                auto *klass = static_cast<StructObject *>(proto->constants[bxOf(code[pc])].AsObject());
+                effects.back().use.setRange(aOf(code[pc]), klass->fieldCount);
+            }
+            else if (opOf(code[pc]) == OpCode::LoadFn)
+            {
+                for (const UpvalueInfo &info : module->protos[bxOf(code[pc])]->upvalues)
+                {
+                    if (!info.isLocal)
+                        continue;
+                    if (info.byValue)
+                        effects.back().use.set(info.index);
+                    else
+                        captured.set(info.index);
+                }
+            }
+        }
+
+        auto liveInOf = [&](const RegSet &out, const Effect &e) {
+            RegSet in = out;
+            if (e.def >= 0)
+                in.clear(static_cast<unsigned>(e.def));
+            in.merge(e.use);
+            in.merge(captured);
+            return in;
+        };
+
+        DynArray<RegSet> liveIn(n + 1), liveOut(n);
+        bool             changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (int pc = n - 1; pc >= 0; --pc)
+            {
+                const Effect &e   = effects[pc];
+                RegSet        out = captured;
+                if (e.fallsThru && pc + 1 < n)
+                    out.merge(liveIn[pc + 1]);
+                if (e.target >= 0 && e.target < n)
+                    out.merge(liveIn[e.target]);
+
+                liveOut[pc] = out;
+                changed |= liveIn[pc].merge(liveInOf(out, e));
+            }
+        }
+
+        for (int pc = 0; pc < n; ++pc)
+        {
+            if (!effects[pc].safepoint)
+                continue;
+
+            RegSet live = liveIn[pc];
+            live.merge(liveOut[pc]);
+
+            proto->safepoints.push_back(static_cast<std::uint32_t>(pc));
+            for (std::uint8_t w = 0; w < proto->liveWords; ++w)
+                proto->liveMaps.push_back(live.words[w]);
+        }
+    }
+} // namespace Fig
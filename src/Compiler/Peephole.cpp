@@ -0,0 +1,229 @@
+/*!
+    @file src/Compiler/Peephole.cpp
+    @brief 发射后窥孔优化：比较-跳转融合与跳转重定位
+*/
+
+#include <Compiler/Compiler.hpp>
+
+#include <limits>
+
+namespace Fig
+{
+    namespace
+    {
+        constexpr int NO_TARGET = -1;
+
+        inline OpCode opOf(Instruction inst)
+        {
+            return static_cast<OpCode>(inst & 0xFF);
+        }
+        inline std::uint8_t aOf(Instruction inst)
+        {
+            return (inst >> 8) & 0xFF;
+        }
+        inline std::uint8_t bOf(Instruction inst)
+        {
+            return (inst >> 16) & 0xFF;
+        }
+        inline std::uint8_t cOf(Instruction inst)
+        {
+            return (inst >> 24) & 0xFF;
+        }
+
+        inline bool isAsBxJump(OpCode op)
+        {
+            return op == OpCode::Jmp || op == OpCode::JmpIfFalse;
+        }
+
+        inline bool isFusedJump(OpCode op)
+        {
+            return op >= OpCode::JmpIfNotLess && op <= OpCode::JmpIfNotLessEqualK;
+        }
+
+        // 跳转指令的绝对目标下标 (非跳转返回 NO_TARGET)
+        int jumpTarget(Instruction inst, int pc)
+        {
+            OpCode op = opOf(inst);
+            if (isAsBxJump(op))
+                return pc + static_cast<std::int16_t>(inst >> 16) + 1;
+            if (isFusedJump(op))
+                return pc + static_cast<std::int8_t>(inst >> 24) + 1;
+            return NO_TARGET;
+        }
+
+        struct FusedCompare
+        {
+            OpCode fused;
+            bool   swap; // a > b  ==> b < a
+        };
+
+        // Cmp + JmpIfFalse 的融合映射，返回 false 表示不可融合
+        bool fusedFor(OpCode cmp, FusedCompare &out)
+        {
+            switch (cmp)
+            {
+                case OpCode::Less: out = {OpCode::JmpIfNotLess, false}; return true;
+                case OpCode::LessEqual: out = {OpCode::JmpIfNotLessEqual, false}; return true;
+                case OpCode::Greater: out = {OpCode::JmpIfNotLess, true}; return true;
+                case OpCode::GreaterEqual: out = {OpCode::JmpIfNotLessEqual, true}; return true;
+                case OpCode::Equal: out = {OpCode::JmpIfNotEqual, false}; return true;
+                case OpCode::NotEqual: out = {OpCode::JmpIfEqual, false}; return true;
+
+                case OpCode::IntFastLess: out = {OpCode::IntJmpIfNotLess, false}; return true;
+                case OpCode::IntFastLessEqual:
+                    out = {OpCode::IntJmpIfNotLessEqual, false};
+                    return true;
+                case OpCode::IntFastGreater: out = {OpCode::IntJmpIfNotLess, true}; return true;
+                case OpCode::IntFastGreaterEqual:
+                    out = {OpCode::IntJmpIfNotLessEqual, true};
+                    return true;
+                case OpCode::IntFastEqual: out = {OpCode::IntJmpIfNotEqual, false}; return true;
+                case OpCode::IntFastNotEqual: out = {OpCode::IntJmpIfEqual, false}; return true;
+
+                // I / K 形式: 常量固定在右侧，不交换
+                case OpCode::EqualI: out = {OpCode::JmpIfNotEqualI, false}; return true;
+                case OpCode::NotEqualI: out = {OpCode::JmpIfEqualI, false}; return true;
+                case OpCode::GreaterI: out = {OpCode::JmpIfNotGreaterI, false}; return true;
+                case OpCode::LessI: out = {OpCode::JmpIfNotLessI, false}; return true;
+                case OpCode::GreaterEqualI: out = {OpCode::JmpIfNotGreaterEqualI, false}; return true;
+                case OpCode::LessEqualI: out = {OpCode::JmpIfNotLessEqualI, false}; return true;
+
+                case OpCode::EqualK: out = {OpCode::JmpIfNotEqualK, false}; return true;
+                case OpCode::NotEqualK: out = {OpCode::JmpIfEqualK, false}; return true;
+                case OpCode::GreaterK: out = {OpCode::JmpIfNotGreaterK, false}; return true;
+                case OpCode::LessK: out = {OpCode::JmpIfNotLessK, false}; return true;
+                case OpCode::GreaterEqualK: out = {OpCode::JmpIfNotGreaterEqualK, false}; return true;
+                case OpCode::LessEqualK: out = {OpCode::JmpIfNotLessEqualK, false}; return true;
+
+                default: return false;
+            }
+        }
+    } // namespace
+
+    /*
+        Cmp    rT, rB, rC
+        JmpIfFalse rT, sBx        ==>   JmpIfNotXxx rB, rC, sC
+
+        I / K 形式同理，rC 换成立即数或常量下标。
+
+        仅当 rT 是条件表达式的临时槽位 (水位线之上，回收后不会再被读取) 时融合，
+        省掉一次分发和一次寄存器写回 + 读取；rT 是具名局部变量时 Cmp 就是它的赋值，
+        必须保留。可融合的 JmpIfFalse 由编译器在发射时登记 (tempCondJumps)。
+        sC 只有 8 位，偏移放不下时保持原样。
+
+        顺带删除 `Jmp +0` (if 分支末尾 return 后残留的出口跳转)。
+    */
+    void Compiler::peephole(Proto *proto, FuncState &fs)
+    {
+        auto  &code = proto->code;
+        int    n    = static_cast<int>(code.size());
+        if (n == 0)
+            return;
+
+        // 记录所有跳转的旧绝对目标
+        DynArray<int>  targets(n, NO_TARGET);
+        DynArray<bool> isTarget(n + 1, false);
+        for (int pc = 0; pc < n; ++pc)
+        {
+            int t       = jumpTarget(code[pc], pc);
+            targets[pc] = t;
+            if (t != NO_TARGET)
+                isTarget[t] = true;
+        }
+
+        DynArray<bool> tempCond(n, false);
+        for (int pc : fs.tempCondJumps)
+            tempCond[pc] = true;
+
+        DynArray<bool> removed(n, false);
+        bool           changed = false;
+
+        for (int pc = 0; pc < n; ++pc)
+        {
+            Instruction inst = code[pc];
+            OpCode      op   = opOf(inst);
+
+            if (op == OpCode::Jmp && targets[pc] == pc + 1)
+            {
+                removed[pc] = true; // 指向它的跳转自然落到下一条
+                changed     = true;
+                continue;
+            }
+
+            FusedCompare fc;
+            if (pc + 1 >= n || !fusedFor(op, fc))
+                continue;
+
+            Instruction next = code[pc + 1];
+            if (opOf(next) != OpCode::JmpIfFalse || aOf(next) != aOf(inst) || !tempCond[pc + 1])
+                continue;
+            if (isTarget[pc + 1]) // 有人跳到 JmpIfFalse 本身，不能删
+                continue;
+
+            int offset = targets[pc + 1] - pc - 1; // 融合后相对 pc 的偏移 (删除只会让它变小)
+            if (offset < std::numeric_limits<std::int8_t>::min()
+                || offset > std::numeric_limits<std::int8_t>::max())
+                continue;
+
+            std::uint8_t lhs = bOf(inst);
+            std::uint8_t rhs = cOf(inst);
+            if (fc.swap)
+                std::swap(lhs, rhs);
+
+            code[pc]        = Op::iABsC(fc.fused, lhs, rhs, 0);
+            targets[pc]     = targets[pc + 1];
+            removed[pc + 1] = true;
+            changed         = true;
+            ++pc;
+        }
+
+        if (!changed)
+            return;
+
+        // 旧下标 -> 新下标；被删除的槽位映射到其后第一条保留指令
+        DynArray<int> newIndex(n + 1);
+        int           kept = 0;
+        for (int pc = 0; pc < n; ++pc)
+        {
+            newIndex[pc] = kept;
+            if (!removed[pc])
+                ++kept;
+        }
+        newIndex[n] = kept;
+
+        DynArray<Instruction>      newCode;
+        DynArray<SourceLocation *> newLocations;
+        newCode.reserve(kept);
+        newLocations.reserve(kept);
+
+        for (int pc = 0; pc < n; ++pc)
+        {
+            if (removed[pc])
+                continue;
+
+            Instruction inst = code[pc];
+            if (targets[pc] != NO_TARGET)
+            {
+                int    offset = newIndex[targets[pc]] - newIndex[pc] - 1;
+                OpCode op     = opOf(inst);
+                if (isFusedJump(op))
+                {
+                    inst = Op::iABsC(op, aOf(inst), bOf(inst), static_cast<std::int8_t>(offset));
+                }
+                else
+                {
+                    inst = Op::iAsBx(op, aOf(inst), static_cast<std::int16_t>(offset));
+                }
+            }
+            newCode.push_back(inst);
+            newLocations.push_back(proto->locations[pc]);
+        }
+
+        proto->code      = std::move(newCode);
+        proto->locations = std::move(newLocations);
+
+        // 字段指令不会被删除，下标直接换成新位置
+        for (auto &site : fs.staticFieldSites)
+            site.first = newIndex[site.first];
+    }
+} // namespace Fig
@@ -3,6 +3,7 @@
     @brief 语句编译器实现：实装水位线机制，彻底消灭硬编码寄存器释放
 */
 
+#include <Ast/Expr/CallExpr.hpp>
 #include <Ast/Stmt/FnDefStmt.hpp>
 #include <Ast/Stmt/IfStmt.hpp>
 #include <Ast/Stmt/VarDecl.hpp>
@@ -84,6 +85,10 @@ namespace Fig
                 Proto *p = module->protos[f->protoIndex];
 
                 p->upvalues = f->upvalues;
+                for (size_t i = 0; i < p->upvalues.size(); ++i)
+                {
+                    p->upvalues[i].byValue = f->captureTargets[i]->capturableByValue;
+                }
 
                 FuncState  fs(p, current);
                 FuncState *old = current;
@@ -93,11 +98,18 @@ namespace Fig
                 if (!res)
                     return res;
 
-                if (p->code.empty() || static_cast<OpCode>(p->code.back() & 0xFF) != OpCode::Return)
+                OpCode lastOp =
+                    p->code.empty() ? OpCode::Exit : static_cast<OpCode>(p->code.back() & 0xFF);
+                if (lastOp != OpCode::Return && lastOp != OpCode::TailCall
+                    && lastOp != OpCode::TailFastCall)
                 {
                     emit(Op::iABC(OpCode::Return, 0, 0, 0), &f->location);
                 }
 
+                peephole(p, fs);
+                seedFieldSites(p, fs);
+                computeLiveness(p);
+
                 current = old;
 
                 // 如果是局部闭包，在当前栈帧分配寄存器并生成 LoadFn
@@ -146,8 +158,7 @@ namespace Fig
                 if (!r_cond)
                     return std::unexpected(r_cond.error());
 
-                int jmpToNext = static_cast<int>(current->proto->code.size());
-                emit(Op::iAsBx(OpCode::JmpIfFalse, *r_cond, 0), &i->location);
+                int jmpToNext = emitCondJump(*r_cond, mark, &i->location);
                 current->freereg = mark; // 回收条件表达式临时槽位
 
                 if (auto r = compileStmt(i->consequent); !r)
@@ -166,8 +177,7 @@ namespace Fig
                     if (!ec)
                         return std::unexpected(ec.error());
 
-                    int nextElif = static_cast<int>(current->proto->code.size());
-                    emit(Op::iAsBx(OpCode::JmpIfFalse, *ec, 0), &elif->location);
+                    int nextElif = emitCondJump(*ec, elifMark, &elif->location);
                     current->freereg = elifMark; // 回收 elif 临时槽位
 
                     if (auto r = compileStmt(elif->consequent); !r)
@@ -177,12 +187,8 @@ namespace Fig
 
                     int target = static_cast<int>(current->proto->code.size());
 
-                    current->proto->code.resize(nextElif);
                     current->proto->code[nextElif] = Op::iAsBx(
                         OpCode::JmpIfFalse, *ec, static_cast<int16_t>(target - nextElif - 1));
-
-                    current->proto->locations.resize(nextElif);
-                    current->proto->locations[nextElif] = &elif->location;
                 }
 
                 if (i->alternate)
@@ -209,8 +215,7 @@ namespace Fig
                 if (!r_cond)
                     return std::unexpected(r_cond.error());
 
-                int exitJmpIdx = static_cast<int>(current->proto->code.size());
-                emit(Op::iAsBx(OpCode::JmpIfFalse, *r_cond, 0), &w->location);
+                int exitJmpIdx = emitCondJump(*r_cond, mark, &w->location);
                 current->freereg = mark; // 回收循环条件临时槽位
 
                 if (auto r = compileStmt(w->body); !r)
@@ -227,7 +232,16 @@ namespace Fig
             }
 
             case AstType::ReturnStmt: {
-                auto    *rs   = static_cast<ReturnStmt *>(stmt);
+                auto *rs = static_cast<ReturnStmt *>(stmt);
+
+                // 函数体内的 return f(...) 走尾调用，不增长调用栈
+                if (rs->value && rs->value->type == AstType::CallExpr && current->enclosing)
+                {
+                    if (auto r = compileTailCall(static_cast<CallExpr *>(rs->value)); !r)
+                        return r;
+                    break;
+                }
+
                 Register mark = current->freereg; // 记录水位线
                 Register retReg;
 
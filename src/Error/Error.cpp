@@ -62,6 +62,10 @@ namespace Fig
 
             case RegisterOverflow: return "RegisterOverflow";
             case InternalError: return "InternalError";
+
+            case StackOverflow: return "StackOverflow";
+            case OutOfMemory: return "OutOfMemory";
+            case DivisionByZero: return "DivisionByZero";
                 // default: return "Some one forgot to add case to `ErrorTypeToString`";
         }
         return "UnknownError";
@@ -54,6 +54,11 @@ namespace Fig
         // --- 新增：编译器内部与VM约束 ---
         RegisterOverflow,
         InternalError,
+
+        // runtime errors
+        StackOverflow,
+        OutOfMemory,
+        DivisionByZero,
     };
 
     const char *ErrorTypeToString(ErrorType type);
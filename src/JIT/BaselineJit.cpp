@@ -0,0 +1,607 @@
+/*!
+    @file src/JIT/BaselineJit.cpp
+    @brief 基线模板 JIT 实现
+*/
+
+#include <JIT/BaselineJit.hpp>
+#include <JIT/X64Emitter.hpp>
+
+namespace Fig::Jit
+{
+#if defined(__FCORE_JIT_X64)
+
+    /*
+        寄存器约定 (两种 ABI 下都是 caller-saved，机器码是叶函数，无需保存任何寄存器)
+            R9  : registerBase
+            R10 : globals
+            RAX, RCX, RDX, R11 : 临时
+
+        每条字节码对应一段模板，入口处通过 pc 跳转表进入任意指令。
+        类型守卫失败时跳到该 pc 的出口桩 `mov eax, pc; ret`，解释器从该指令重新执行，
+        因此守卫必须发生在任何写回之前。
+    */
+    class BaselineJitTranslator
+    {
+    private:
+        static constexpr Reg REGS    = Reg::R9;
+        static constexpr Reg GLOBALS = Reg::R10;
+
+        struct Fixup
+        {
+            std::size_t   at;     // rel32 字段偏移
+            std::uint32_t pc;     // 目标 pc
+            bool          toExit; // 跳到该 pc 的出口桩而不是指令本身
+        };
+
+        const Proto &proto;
+        X64Emitter   as;
+
+        DynArray<std::size_t> labels;
+        DynArray<Fixup>       fixups;
+        std::size_t           tableImmAt = 0;
+
+        BaselineJit::ValueBits bits;
+
+    public:
+        explicit BaselineJitTranslator(const Proto &p) : proto(p), bits(BaselineJit::Bits()) {}
+
+        X64Emitter &Emitter()
+        {
+            return as;
+        }
+
+        std::size_t TableImmAt() const
+        {
+            return tableImmAt;
+        }
+
+        const DynArray<std::size_t> &Labels() const
+        {
+            return labels;
+        }
+
+        void Translate()
+        {
+            const auto n = static_cast<std::uint32_t>(proto.code.size());
+            labels.assign(n, 0);
+
+            emitPrologue();
+            for (std::uint32_t pc = 0; pc < n; ++pc)
+            {
+                labels[pc] = as.Size();
+                if (!emitInstruction(pc, proto.code[pc]))
+                {
+                    emitExit(pc); // 未覆盖的指令：原样交给解释器
+                }
+            }
+
+            // 出口桩：每个 pc 至多一个
+            DynArray<std::size_t> exitStubs(n, SIZE_MAX);
+            for (const Fixup &f : fixups)
+            {
+                std::size_t target;
+                if (f.toExit)
+                {
+                    if (exitStubs[f.pc] == SIZE_MAX)
+                    {
+                        exitStubs[f.pc] = as.Size();
+                        emitExit(f.pc);
+                    }
+                    target = exitStubs[f.pc];
+                }
+                else
+                {
+                    target = labels[f.pc];
+                }
+                as.Bind(f.at, target);
+            }
+        }
+
+    private:
+        static std::int32_t slot(std::uint32_t reg)
+        {
+            return static_cast<std::int32_t>(reg * sizeof(Value));
+        }
+
+        void emitPrologue()
+        {
+#if defined(_WIN32)
+            as.MovReg64(REGS, Reg::RCX);
+            as.MovReg64(GLOBALS, Reg::RDX);
+            as.MovReg32(Reg::RAX, Reg::R8);
+#else
+            as.MovReg64(REGS, Reg::RDI);
+            as.MovReg64(GLOBALS, Reg::RSI);
+            as.MovReg32(Reg::RAX, Reg::RDX);
+#endif
+            tableImmAt = as.MovImm64(Reg::R11, 0); // 跳转表地址，定稿后回填
+            as.JmpTable(Reg::R11, Reg::RAX);
+        }
+
+        void emitExit(std::uint32_t pc)
+        {
+            as.Byte(0xB8); // mov eax, imm32
+            as.Dword(pc);
+            as.Ret();
+        }
+
+        void jumpTo(std::size_t at, std::uint32_t pc)
+        {
+            fixups.push_back({at, pc, false});
+        }
+
+        void exitTo(std::size_t at, std::uint32_t pc)
+        {
+            fixups.push_back({at, pc, true});
+        }
+
+        void load(Reg dst, std::uint32_t reg)
+        {
+            as.MovLoad64(dst, REGS, slot(reg));
+        }
+
+        void store(std::uint32_t reg, Reg src)
+        {
+            as.MovStore64(REGS, slot(reg), src);
+        }
+
+        // v 不是 Int 时退出到 pc (破坏 RDX)
+        void guardInt(Reg v, std::uint32_t pc)
+        {
+            as.MovReg64(Reg::RDX, v);
+            as.Shr64(Reg::RDX, 48);
+            as.Alu32Imm(AluOp::Cmp, Reg::RDX, static_cast<std::int32_t>(bits.intTagHigh));
+            exitTo(as.Jcc(Cond::NE), pc);
+        }
+
+        // RAX 低 48 位装箱为 Int (要求高 16 位已清零)
+        void boxInt()
+        {
+            as.MovImm64(Reg::RDX, bits.intTag);
+            as.Alu64(AluOp::Or, Reg::RAX, Reg::RDX);
+        }
+
+        // 紧跟 cmp 之后：RAX = cond ? true : false
+        void boxBool(Cond cond)
+        {
+            as.SetccEax(cond);
+            as.MovImm64(Reg::RDX, bits.falseBits); // TAG_TRUE = TAG_FALSE | 1
+            as.Alu64(AluOp::Or, Reg::RAX, Reg::RDX);
+        }
+
+        static bool arithOf(OpCode op, AluOp &alu, bool &isMul)
+        {
+            isMul = false;
+            switch (op)
+            {
+                case OpCode::Add:
+                case OpCode::AddInt:
+                case OpCode::AddDouble:
+                case OpCode::IntFastAdd:
+                case OpCode::AddI:
+                case OpCode::AddK: alu = AluOp::Add; return true;
+                case OpCode::Sub:
+                case OpCode::SubInt:
+                case OpCode::SubDouble:
+                case OpCode::IntFastSub:
+                case OpCode::SubI:
+                case OpCode::SubK: alu = AluOp::Sub; return true;
+                case OpCode::Mul:
+                case OpCode::MulInt:
+                case OpCode::MulDouble:
+                case OpCode::IntFastMul:
+                case OpCode::MulI:
+                case OpCode::MulK:
+                    alu   = AluOp::Add;
+                    isMul = true;
+                    return true;
+                default: return false;
+            }
+        }
+
+        // 比较类指令 -> 条件成立时的 x86 条件码 (有符号)
+        static bool condOf(OpCode op, Cond &cond)
+        {
+            switch (op)
+            {
+                case OpCode::Equal:
+                case OpCode::IntFastEqual:
+                case OpCode::EqualI:
+                case OpCode::EqualK: cond = Cond::E; return true;
+                case OpCode::NotEqual:
+                case OpCode::IntFastNotEqual:
+                case OpCode::NotEqualI:
+                case OpCode::NotEqualK: cond = Cond::NE; return true;
+                case OpCode::Greater:
+                case OpCode::GreaterInt:
+                case OpCode::GreaterDouble:
+                case OpCode::IntFastGreater:
+                case OpCode::GreaterI:
+                case OpCode::GreaterK: cond = Cond::G; return true;
+                case OpCode::Less:
+                case OpCode::LessInt:
+                case OpCode::LessDouble:
+                case OpCode::IntFastLess:
+                case OpCode::LessI:
+                case OpCode::LessK: cond = Cond::L; return true;
+                case OpCode::GreaterEqual:
+                case OpCode::GreaterEqualInt:
+                case OpCode::GreaterEqualDouble:
+                case OpCode::IntFastGreaterEqual:
+                case OpCode::GreaterEqualI:
+                case OpCode::GreaterEqualK: cond = Cond::GE; return true;
+                case OpCode::LessEqual:
+                case OpCode::LessEqualInt:
+                case OpCode::LessEqualDouble:
+                case OpCode::IntFastLessEqual:
+                case OpCode::LessEqualI:
+                case OpCode::LessEqualK: cond = Cond::LE; return true;
+                default: return false;
+            }
+        }
+
+        // 融合跳转 -> 条件成立时的条件码 (不成立时跳转)
+        static bool fusedCondOf(OpCode op, Cond &cond)
+        {
+            switch (op)
+            {
+                case OpCode::JmpIfNotLess:
+                case OpCode::JmpIfNotLessInt:
+                case OpCode::JmpIfNotLessDouble:
+                case OpCode::IntJmpIfNotLess:
+                case OpCode::JmpIfNotLessI:
+                case OpCode::JmpIfNotLessK: cond = Cond::L; return true;
+                case OpCode::JmpIfNotLessEqual:
+                case OpCode::JmpIfNotLessEqualInt:
+                case OpCode::JmpIfNotLessEqualDouble:
+                case OpCode::IntJmpIfNotLessEqual:
+                case OpCode::JmpIfNotLessEqualI:
+                case OpCode::JmpIfNotLessEqualK: cond = Cond::LE; return true;
+                case OpCode::JmpIfNotEqual:
+                case OpCode::IntJmpIfNotEqual:
+                case OpCode::JmpIfNotEqualI:
+                case OpCode::JmpIfNotEqualK: cond = Cond::E; return true;
+                case OpCode::JmpIfEqual:
+                case OpCode::IntJmpIfEqual:
+                case OpCode::JmpIfEqualI:
+                case OpCode::JmpIfEqualK: cond = Cond::NE; return true;
+                case OpCode::JmpIfNotGreaterI:
+                case OpCode::JmpIfNotGreaterK: cond = Cond::G; return true;
+                case OpCode::JmpIfNotGreaterEqualI:
+                case OpCode::JmpIfNotGreaterEqualK: cond = Cond::GE; return true;
+                default: return false;
+            }
+        }
+
+        // 操作数可能是 Int 也可能是 Double 的算术 (含运行时特化出的 Double 形式)
+        static bool isGenericArith(OpCode op)
+        {
+            switch (op)
+            {
+                case OpCode::Add:
+                case OpCode::Sub:
+                case OpCode::Mul:
+                case OpCode::AddDouble:
+                case OpCode::SubDouble:
+                case OpCode::MulDouble: return true;
+                default: return false;
+            }
+        }
+
+        static bool isImmForm(OpCode op)
+        {
+            switch (op)
+            {
+                case OpCode::AddI:
+                case OpCode::SubI:
+                case OpCode::MulI:
+                case OpCode::EqualI:
+                case OpCode::NotEqualI:
+                case OpCode::GreaterI:
+                case OpCode::LessI:
+                case OpCode::GreaterEqualI:
+                case OpCode::LessEqualI: return true;
+                default: return op >= OpCode::JmpIfNotEqualI && op <= OpCode::JmpIfNotLessEqualI;
+            }
+        }
+
+        static bool isConstForm(OpCode op)
+        {
+            switch (op)
+            {
+                case OpCode::AddK:
+                case OpCode::SubK:
+                case OpCode::MulK:
+                case OpCode::EqualK:
+                case OpCode::NotEqualK:
+                case OpCode::GreaterK:
+                case OpCode::LessK:
+                case OpCode::GreaterEqualK:
+                case OpCode::LessEqualK: return true;
+                default: return op >= OpCode::JmpIfNotEqualK && op <= OpCode::JmpIfNotLessEqualK;
+            }
+        }
+
+        // 右操作数为编译期已知的 int (I 形式或 Int 常量)
+        bool rhsImmediate(OpCode op, std::uint8_t operand, std::int64_t &imm) const
+        {
+            if (isImmForm(op))
+            {
+                imm = static_cast<std::int8_t>(operand);
+                return true;
+            }
+            if (isConstForm(op) && operand < proto.constants.size()
+                && proto.constants[operand].IsInt())
+            {
+                imm = proto.constants[operand].AsInt();
+                return true;
+            }
+            return false;
+        }
+
+        /*
+            RAX、RCX 为已通过 guardInt 的 Int。载荷左移 16 位放到寄存器高 48 位，
+            64 位运算的 OF 正好是 48 位溢出；溢出时退出到 pc，由解释器提升为 BigInt
+        */
+        void shiftedRhs(bool useImm, std::int64_t imm)
+        {
+            if (useImm)
+                as.MovImm64(Reg::RCX, static_cast<std::uint64_t>(imm) << 16);
+            else
+                as.Shl64(Reg::RCX, 16);
+        }
+
+        // RAX (int) op= RCX 或立即数
+        void intArith(AluOp alu, bool isMul, bool useImm, std::int64_t imm, std::uint32_t pc)
+        {
+            as.Shl64(Reg::RAX, 16);
+            if (isMul)
+            {
+                // 乘数不移位：(a << 16) * b
+                if (useImm)
+                {
+                    as.MovImm64(Reg::RCX, static_cast<std::uint64_t>(imm));
+                }
+                else
+                {
+                    as.Shl64(Reg::RCX, 16);
+                    as.Sar64(Reg::RCX, 16);
+                }
+                as.Imul64(Reg::RAX, Reg::RCX);
+            }
+            else
+            {
+                shiftedRhs(useImm, imm);
+                as.Alu64(alu, Reg::RAX, Reg::RCX);
+            }
+            exitTo(as.Jcc(Cond::O), pc);
+            as.Shr64(Reg::RAX, 16);
+            boxInt();
+        }
+
+        // 有符号比较 RAX 与 RCX 或立即数 (同样在左移 16 位后比较)
+        void intCompare(bool useImm, std::int64_t imm)
+        {
+            as.Shl64(Reg::RAX, 16);
+            shiftedRhs(useImm, imm);
+            as.Alu64(AluOp::Cmp, Reg::RAX, Reg::RCX);
+        }
+
+        // 两个操作数都是 double 时走 SSE，否则退出 (RAX、RCX 为操作数)
+        void doubleArith(OpCode op, std::uint32_t pc)
+        {
+            for (Reg v : {Reg::RAX, Reg::RCX})
+            {
+                as.MovImm64(Reg::RDX, bits.qnanMask);
+                as.MovReg64(Reg::R11, v);
+                as.Alu64(AluOp::And, Reg::R11, Reg::RDX);
+                as.Alu64(AluOp::Cmp, Reg::R11, Reg::RDX);
+                exitTo(as.Jcc(Cond::E), pc); // 非 double (含 Int)
+            }
+
+            AluOp alu;
+            bool  isMul;
+            arithOf(op, alu, isMul);
+            SseOp sse = isMul ? SseOp::Mul : alu == AluOp::Add ? SseOp::Add : SseOp::Sub;
+            as.MovqToXmm(XmmReg::XMM0, Reg::RAX);
+            as.MovqToXmm(XmmReg::XMM1, Reg::RCX);
+            as.SseArith(sse, XmmReg::XMM0, XmmReg::XMM1);
+            as.MovqFromXmm(Reg::RAX, XmmReg::XMM0);
+
+            // 与 Value::FromDouble 一致：运算产生的 NaN 会与 tag 冲突，清洗为 QNAN_MASK
+            as.MovImm64(Reg::RDX, bits.qnanMask);
+            as.MovReg64(Reg::R11, Reg::RAX);
+            as.Alu64(AluOp::And, Reg::R11, Reg::RDX);
+            as.Alu64(AluOp::Cmp, Reg::R11, Reg::RDX);
+            std::size_t ok = as.Jcc(Cond::NE);
+            as.MovReg64(Reg::RAX, Reg::RDX);
+            as.Bind(ok, as.Size());
+        }
+
+        bool emitInstruction(std::uint32_t pc, Instruction inst)
+        {
+            OpCode       op = static_cast<OpCode>(inst & 0xFF);
+            std::uint8_t a  = (inst >> 8) & 0xFF;
+            std::uint8_t b  = (inst >> 16) & 0xFF;
+            std::uint8_t c  = (inst >> 24) & 0xFF;
+            std::uint16_t bx  = (inst >> 16) & 0xFFFF;
+            std::int16_t  sbx = static_cast<std::int16_t>(inst >> 16);
+            std::int8_t   sc  = static_cast<std::int8_t>(inst >> 24);
+
+            AluOp alu;
+            bool  isMul;
+            Cond  cond;
+
+            switch (op)
+            {
+                case OpCode::LoadK:
+                    as.MovImm64(Reg::RAX, proto.constants[bx].Raw());
+                    store(a, Reg::RAX);
+                    return true;
+                case OpCode::LoadTrue:
+                    as.MovImm64(Reg::RAX, bits.trueBits);
+                    store(a, Reg::RAX);
+                    return true;
+                case OpCode::LoadFalse:
+                    as.MovImm64(Reg::RAX, bits.falseBits);
+                    store(a, Reg::RAX);
+                    return true;
+                case OpCode::LoadNull:
+                    as.MovImm64(Reg::RAX, bits.nullBits);
+                    store(a, Reg::RAX);
+                    return true;
+
+                case OpCode::Mov:
+                    load(Reg::RAX, bx);
+                    store(a, Reg::RAX);
+                    return true;
+
+                case OpCode::GetGlobal:
+                    as.MovLoad64(Reg::RAX, GLOBALS, slot(bx));
+                    store(a, Reg::RAX);
+                    return true;
+                case OpCode::SetGlobal:
+                    load(Reg::RAX, a);
+                    as.MovStore64(GLOBALS, slot(bx), Reg::RAX);
+                    return true;
+
+                case OpCode::Jmp: jumpTo(as.Jmp(), pc + 1 + sbx); return true;
+
+                case OpCode::JmpIfFalse:
+                    load(Reg::RAX, a);
+                    as.MovImm64(Reg::RCX, bits.trueBits);
+                    as.Alu64(AluOp::Cmp, Reg::RAX, Reg::RCX);
+                    jumpTo(as.Jcc(Cond::NE), pc + 1 + sbx);
+                    return true;
+
+                default: break;
+            }
+
+            if (arithOf(op, alu, isMul))
+            {
+                std::int64_t imm    = 0;
+                bool         useImm = rhsImmediate(op, c, imm);
+                if ((isImmForm(op) || isConstForm(op)) && !useImm)
+                    return false; // double 常量：交给解释器
+
+                load(Reg::RAX, b);
+                if (isGenericArith(op))
+                {
+                    // 泛型算术：int/int 内联，double/double 走 SSE，混合类型退出
+                    load(Reg::RCX, c);
+                    as.MovReg64(Reg::RDX, Reg::RAX);
+                    as.Shr64(Reg::RDX, 48);
+                    as.Alu32Imm(AluOp::Cmp, Reg::RDX, static_cast<std::int32_t>(bits.intTagHigh));
+                    std::size_t notInt = as.Jcc(Cond::NE);
+
+                    guardInt(Reg::RCX, pc);
+                    intArith(alu, isMul, false, 0, pc);
+                    std::size_t done = as.Jmp();
+
+                    as.Bind(notInt, as.Size());
+                    doubleArith(op, pc);
+                    as.Bind(done, as.Size());
+                }
+                else
+                {
+                    guardInt(Reg::RAX, pc);
+                    if (!useImm)
+                    {
+                        load(Reg::RCX, c);
+                        guardInt(Reg::RCX, pc);
+                    }
+                    intArith(alu, isMul, useImm, imm, pc);
+                }
+                store(a, Reg::RAX);
+                return true;
+            }
+
+            if (condOf(op, cond))
+            {
+                std::int64_t imm    = 0;
+                bool         useImm = rhsImmediate(op, c, imm);
+                if ((isImmForm(op) || isConstForm(op)) && !useImm)
+                    return false;
+
+                load(Reg::RAX, b);
+                guardInt(Reg::RAX, pc);
+                if (!useImm)
+                {
+                    load(Reg::RCX, c);
+                    guardInt(Reg::RCX, pc);
+                }
+                intCompare(useImm, imm);
+                boxBool(cond);
+                store(a, Reg::RAX);
+                return true;
+            }
+
+            if (fusedCondOf(op, cond))
+            {
+                std::int64_t imm    = 0;
+                bool         useImm = rhsImmediate(op, b, imm);
+                if ((isImmForm(op) || isConstForm(op)) && !useImm)
+                    return false;
+
+                load(Reg::RAX, a);
+                guardInt(Reg::RAX, pc);
+                if (!useImm)
+                {
+                    load(Reg::RCX, b);
+                    guardInt(Reg::RCX, pc);
+                }
+                intCompare(useImm, imm);
+                jumpTo(as.Jcc(Invert(cond)), pc + 1 + sc);
+                return true;
+            }
+
+            // 调用 / 返回 / 闭包 / upvalue / 除法等：退回解释器
+            return false;
+        }
+    };
+
+    JitCode *BaselineJit::Compile(const Proto *proto)
+    {
+        if (proto->code.empty())
+            return nullptr;
+
+        BaselineJitTranslator translator(*proto);
+        translator.Translate();
+
+        X64Emitter &as = translator.Emitter();
+
+        // [code][pad][pc 跳转表]
+        std::size_t tableOffset = (as.Size() + 7) & ~std::size_t(7);
+        std::size_t total       = tableOffset + proto->code.size() * sizeof(void *);
+
+        auto jc = std::make_unique<JitCode>();
+        if (!jc->memory.Allocate(total))
+            return nullptr;
+
+        std::uint8_t *base = jc->memory.Data();
+        as.PatchQword(translator.TableImmAt(), reinterpret_cast<std::uint64_t>(base + tableOffset));
+        std::memcpy(base, as.code.data(), as.Size());
+
+        auto *table = reinterpret_cast<std::uint8_t **>(base + tableOffset);
+        for (std::size_t pc = 0; pc < proto->code.size(); ++pc)
+        {
+            table[pc] = base + translator.Labels()[pc];
+        }
+
+        if (!jc->memory.Seal())
+            return nullptr;
+
+        jc->entry = reinterpret_cast<EntryFn>(base);
+        codes.push_back(std::move(jc));
+        return codes.back().get();
+    }
+
+#else
+
+    JitCode *BaselineJit::Compile(const Proto *)
+    {
+        return nullptr;
+    }
+
+#endif
+} // namespace Fig::Jit
@@ -0,0 +1,78 @@
+/*!
+    @file src/JIT/BaselineJit.hpp
+    @brief 基线模板 JIT：把热点 Proto 的字节码逐条翻译为 x86-64 机器码
+*/
+
+#pragma once
+
+#include <Bytecode/Bytecode.hpp>
+#include <JIT/ExecutableMemory.hpp>
+
+#include <memory>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define __FCORE_JIT_X64
+#endif
+
+namespace Fig::Jit
+{
+    /*
+        机器码入口：从 startPc 对应的指令开始执行，
+        返回解释器应当接着执行的 pc (该指令尚未执行)。
+
+        机器码只在同一个 CallFrame 内运行，不压帧、不分配对象；
+        调用、返回、未覆盖的指令以及类型守卫失败都退回解释器。
+    */
+    using EntryFn = std::uint32_t (*)(Value *registerBase, Value *globals, std::uint32_t startPc);
+
+    struct JitCode
+    {
+        ExecutableMemory memory;
+        EntryFn          entry = nullptr;
+    };
+
+    class BaselineJit
+    {
+    private:
+        DynArray<std::unique_ptr<JitCode>> codes;
+
+    public:
+        // NaN-boxing 位模式 (取自 Value 的私有常量)，模板直接拼装
+        struct ValueBits
+        {
+            std::uint64_t intTag;     // Int 的高 16 位 tag (已左移)，低 48 位为补码载荷
+            std::uint32_t intTagHigh; // 同上，未移位
+            std::uint64_t qnanMask;
+            std::uint64_t falseBits;
+            std::uint64_t trueBits;
+            std::uint64_t nullBits;
+        };
+
+        static ValueBits Bits()
+        {
+            return {Value::INT_TAG,
+                Value::INT_TAG_HIGH,
+                Value::QNAN_MASK,
+                Value::QNAN_MASK | Value::TAG_FALSE,
+                Value::QNAN_MASK | Value::TAG_TRUE,
+                Value::QNAN_MASK | Value::TAG_NULL};
+        }
+
+        static constexpr bool IsSupported()
+        {
+#if defined(__FCORE_JIT_X64)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        // 编译失败 (平台不支持 / 内存不足) 返回 nullptr，调用方继续解释执行
+        JitCode *Compile(const Proto *proto);
+
+        std::size_t CompiledCount() const
+        {
+            return codes.size();
+        }
+    };
+} // namespace Fig::Jit
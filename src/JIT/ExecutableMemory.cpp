@@ -0,0 +1,52 @@
+/*!
+    @file src/JIT/ExecutableMemory.cpp
+    @brief JIT 可执行内存实现 (mmap / VirtualAlloc)
+*/
+
+#include <JIT/ExecutableMemory.hpp>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace Fig::Jit
+{
+    ExecutableMemory::~ExecutableMemory()
+    {
+        if (!base)
+            return;
+#if defined(_WIN32)
+        VirtualFree(base, 0, MEM_RELEASE);
+#else
+        munmap(base, size);
+#endif
+    }
+
+    bool ExecutableMemory::Allocate(std::size_t bytes)
+    {
+#if defined(_WIN32)
+        void *p = VirtualAlloc(nullptr, bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+        if (!p)
+            return false;
+#else
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            return false;
+#endif
+        base = static_cast<std::uint8_t *>(p);
+        size = bytes;
+        return true;
+    }
+
+    bool ExecutableMemory::Seal()
+    {
+#if defined(_WIN32)
+        DWORD old;
+        return VirtualProtect(base, size, PAGE_EXECUTE_READ, &old) != 0;
+#else
+        return mprotect(base, size, PROT_READ | PROT_EXEC) == 0;
+#endif
+    }
+} // namespace Fig::Jit
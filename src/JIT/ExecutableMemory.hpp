@@ -0,0 +1,36 @@
+/*!
+    @file src/JIT/ExecutableMemory.hpp
+    @brief JIT 可执行内存：先写后执行 (W^X)，写入完成后翻转为 RX
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Fig::Jit
+{
+    class ExecutableMemory
+    {
+    private:
+        std::uint8_t *base = nullptr;
+        std::size_t   size = 0;
+
+    public:
+        ExecutableMemory() = default;
+        ExecutableMemory(const ExecutableMemory &)            = delete;
+        ExecutableMemory &operator=(const ExecutableMemory &) = delete;
+        ~ExecutableMemory();
+
+        // 分配可写页，失败返回 false
+        bool Allocate(std::size_t bytes);
+
+        // 写入结束，改为只读可执行
+        bool Seal();
+
+        std::uint8_t *Data() const
+        {
+            return base;
+        }
+    };
+} // namespace Fig::Jit
@@ -0,0 +1,831 @@
+/*!
+    @file src/JIT/TraceJit.cpp
+    @brief 追踪 JIT 实现：迭代推演 (记录) + 剥离首轮的特化编译
+*/
+
+#include <JIT/TraceJit.hpp>
+#include <JIT/X64Emitter.hpp>
+
+#include <unordered_map>
+
+namespace Fig::Jit
+{
+#if defined(__FCORE_JIT_X64)
+
+    namespace
+    {
+        // 寄存器 r 的变量号为 r，全局 g 的变量号为 GlobalBase + g
+        constexpr std::uint32_t GlobalBase = 256;
+
+        enum class VType : std::uint8_t
+        {
+            Unknown,
+            Int,
+            Double,
+            Bool,
+            Other,
+        };
+
+        VType typeOf(const Value &v)
+        {
+            if (v.IsInt())
+                return VType::Int;
+            if (v.IsDouble())
+                return VType::Double;
+            if (v.IsBool())
+                return VType::Bool;
+            return VType::Other;
+        }
+
+        bool isNumeric(VType t)
+        {
+            return t == VType::Int || t == VType::Double;
+        }
+
+        enum class ArithOp : std::uint8_t
+        {
+            Add,
+            Sub,
+            Mul,
+        };
+
+        enum class CmpOp : std::uint8_t
+        {
+            Eq,
+            Ne,
+            Lt,
+            Le,
+            Gt,
+            Ge,
+        };
+
+        // 右操作数形式
+        enum class Form : std::uint8_t
+        {
+            Reg,   // R[C]
+            Imm,   // int8 立即数
+            Const, // K[C]
+        };
+
+        struct Operand
+        {
+            bool          isConst = false;
+            std::uint32_t var     = 0;
+            Value         k;
+        };
+
+        enum class Kind : std::uint8_t
+        {
+            Load,      // dst = k
+            Move,      // dst = src (寄存器 / 全局之间)
+            Arith,     // dst = lhs op rhs
+            Compare,   // dst = lhs op rhs (Bool)
+            Branch,    // JmpIfFalse: 期望 lhs 的真假
+            CmpBranch, // 比较-跳转融合: 期望条件的真假
+        };
+
+        struct TraceOp
+        {
+            Kind          kind;
+            std::uint32_t pc;
+            std::uint32_t dst = 0;
+            Operand       lhs, rhs;
+            VType         lhsSeen = VType::Unknown;
+            VType         rhsSeen = VType::Unknown;
+            ArithOp       arith   = ArithOp::Add;
+            CmpOp         cmp     = CmpOp::Eq;
+            bool          expect  = false; // 记录时观测到的结果
+            std::uint32_t exitPc  = 0;     // 分支走另一侧时解释器的恢复点
+        };
+
+        bool arithOf(OpCode op, ArithOp &arith, Form &form, bool &intOnly)
+        {
+            intOnly = false;
+            switch (op)
+            {
+                case OpCode::Add:
+                case OpCode::AddInt:
+                case OpCode::AddDouble: arith = ArithOp::Add, form = Form::Reg; return true;
+                case OpCode::Sub:
+                case OpCode::SubInt:
+                case OpCode::SubDouble: arith = ArithOp::Sub, form = Form::Reg; return true;
+                case OpCode::Mul:
+                case OpCode::MulInt:
+                case OpCode::MulDouble: arith = ArithOp::Mul, form = Form::Reg; return true;
+                case OpCode::IntFastAdd: arith = ArithOp::Add, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntFastSub: arith = ArithOp::Sub, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntFastMul: arith = ArithOp::Mul, form = Form::Reg, intOnly = true; return true;
+                case OpCode::AddI: arith = ArithOp::Add, form = Form::Imm; return true;
+                case OpCode::SubI: arith = ArithOp::Sub, form = Form::Imm; return true;
+                case OpCode::MulI: arith = ArithOp::Mul, form = Form::Imm; return true;
+                case OpCode::AddK: arith = ArithOp::Add, form = Form::Const; return true;
+                case OpCode::SubK: arith = ArithOp::Sub, form = Form::Const; return true;
+                case OpCode::MulK: arith = ArithOp::Mul, form = Form::Const; return true;
+                default: return false;
+            }
+        }
+
+        bool compareOf(OpCode op, CmpOp &cmp, Form &form, bool &intOnly)
+        {
+            intOnly = false;
+            switch (op)
+            {
+                case OpCode::Equal: cmp = CmpOp::Eq, form = Form::Reg; return true;
+                case OpCode::NotEqual: cmp = CmpOp::Ne, form = Form::Reg; return true;
+                case OpCode::Greater:
+                case OpCode::GreaterInt:
+                case OpCode::GreaterDouble: cmp = CmpOp::Gt, form = Form::Reg; return true;
+                case OpCode::Less:
+                case OpCode::LessInt:
+                case OpCode::LessDouble: cmp = CmpOp::Lt, form = Form::Reg; return true;
+                case OpCode::GreaterEqual:
+                case OpCode::GreaterEqualInt:
+                case OpCode::GreaterEqualDouble: cmp = CmpOp::Ge, form = Form::Reg; return true;
+                case OpCode::LessEqual:
+                case OpCode::LessEqualInt:
+                case OpCode::LessEqualDouble: cmp = CmpOp::Le, form = Form::Reg; return true;
+                case OpCode::IntFastEqual: cmp = CmpOp::Eq, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntFastNotEqual: cmp = CmpOp::Ne, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntFastGreater: cmp = CmpOp::Gt, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntFastLess: cmp = CmpOp::Lt, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntFastGreaterEqual: cmp = CmpOp::Ge, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntFastLessEqual: cmp = CmpOp::Le, form = Form::Reg, intOnly = true; return true;
+                case OpCode::EqualI: cmp = CmpOp::Eq, form = Form::Imm; return true;
+                case OpCode::NotEqualI: cmp = CmpOp::Ne, form = Form::Imm; return true;
+                case OpCode::GreaterI: cmp = CmpOp::Gt, form = Form::Imm; return true;
+                case OpCode::LessI: cmp = CmpOp::Lt, form = Form::Imm; return true;
+                case OpCode::GreaterEqualI: cmp = CmpOp::Ge, form = Form::Imm; return true;
+                case OpCode::LessEqualI: cmp = CmpOp::Le, form = Form::Imm; return true;
+                case OpCode::EqualK: cmp = CmpOp::Eq, form = Form::Const; return true;
+                case OpCode::NotEqualK: cmp = CmpOp::Ne, form = Form::Const; return true;
+                case OpCode::GreaterK: cmp = CmpOp::Gt, form = Form::Const; return true;
+                case OpCode::LessK: cmp = CmpOp::Lt, form = Form::Const; return true;
+                case OpCode::GreaterEqualK: cmp = CmpOp::Ge, form = Form::Const; return true;
+                case OpCode::LessEqualK: cmp = CmpOp::Le, form = Form::Const; return true;
+                default: return false;
+            }
+        }
+
+        // 融合跳转：cmp 为顺序执行 (不跳转) 所需的条件
+        bool fusedOf(OpCode op, CmpOp &cmp, Form &form, bool &intOnly)
+        {
+            intOnly = false;
+            switch (op)
+            {
+                case OpCode::JmpIfNotLess:
+                case OpCode::JmpIfNotLessInt:
+                case OpCode::JmpIfNotLessDouble: cmp = CmpOp::Lt, form = Form::Reg; return true;
+                case OpCode::JmpIfNotLessEqual:
+                case OpCode::JmpIfNotLessEqualInt:
+                case OpCode::JmpIfNotLessEqualDouble: cmp = CmpOp::Le, form = Form::Reg; return true;
+                case OpCode::JmpIfNotEqual: cmp = CmpOp::Eq, form = Form::Reg; return true;
+                case OpCode::JmpIfEqual: cmp = CmpOp::Ne, form = Form::Reg; return true;
+                case OpCode::IntJmpIfNotLess: cmp = CmpOp::Lt, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntJmpIfNotLessEqual: cmp = CmpOp::Le, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntJmpIfNotEqual: cmp = CmpOp::Eq, form = Form::Reg, intOnly = true; return true;
+                case OpCode::IntJmpIfEqual: cmp = CmpOp::Ne, form = Form::Reg, intOnly = true; return true;
+                case OpCode::JmpIfNotEqualI: cmp = CmpOp::Eq, form = Form::Imm; return true;
+                case OpCode::JmpIfEqualI: cmp = CmpOp::Ne, form = Form::Imm; return true;
+                case OpCode::JmpIfNotGreaterI: cmp = CmpOp::Gt, form = Form::Imm; return true;
+                case OpCode::JmpIfNotLessI: cmp = CmpOp::Lt, form = Form::Imm; return true;
+                case OpCode::JmpIfNotGreaterEqualI: cmp = CmpOp::Ge, form = Form::Imm; return true;
+                case OpCode::JmpIfNotLessEqualI: cmp = CmpOp::Le, form = Form::Imm; return true;
+                case OpCode::JmpIfNotEqualK: cmp = CmpOp::Eq, form = Form::Const; return true;
+                case OpCode::JmpIfEqualK: cmp = CmpOp::Ne, form = Form::Const; return true;
+                case OpCode::JmpIfNotGreaterK: cmp = CmpOp::Gt, form = Form::Const; return true;
+                case OpCode::JmpIfNotLessK: cmp = CmpOp::Lt, form = Form::Const; return true;
+                case OpCode::JmpIfNotGreaterEqualK: cmp = CmpOp::Ge, form = Form::Const; return true;
+                case OpCode::JmpIfNotLessEqualK: cmp = CmpOp::Le, form = Form::Const; return true;
+                default: return false;
+            }
+        }
+
+        double toDouble(const Value &v)
+        {
+            return v.IsInt() ? static_cast<double>(v.AsInt()) : v.AsDouble();
+        }
+
+        /*
+            与 NUMERIC_ARITHMETIC 同语义。Int 溢出 48 位时解释器提升为 BigInt，
+            trace 不覆盖该类型，返回 false 让记录器放弃本次记录
+        */
+        bool simArith(ArithOp op, const Value &l, const Value &r, Value &out)
+        {
+            if (l.IsInt() && r.IsInt())
+            {
+                std::int64_t x = l.AsInt(), y = r.AsInt(), z;
+                bool         ok = op == ArithOp::Add ? Value::CheckedAdd(x, y, z)
+                                : op == ArithOp::Sub ? Value::CheckedSub(x, y, z)
+                                                     : Value::CheckedMul(x, y, z);
+                if (ok)
+                    out = Value::FromInt(z);
+                return ok;
+            }
+            double x = toDouble(l), y = toDouble(r);
+            out      = Value::FromDouble(op == ArithOp::Add ? x + y : op == ArithOp::Sub ? x - y : x * y);
+            return true;
+        }
+
+        template <typename T>
+        bool compareAs(CmpOp op, T x, T y)
+        {
+            switch (op)
+            {
+                case CmpOp::Eq: return x == y;
+                case CmpOp::Ne: return x != y;
+                case CmpOp::Lt: return x < y;
+                case CmpOp::Le: return x <= y;
+                case CmpOp::Gt: return x > y;
+                case CmpOp::Ge: return x >= y;
+            }
+            return false;
+        }
+
+        // 与 NUMERIC_COMPARE 同语义
+        bool simCompare(CmpOp op, const Value &l, const Value &r)
+        {
+            if (l.IsInt() && r.IsInt())
+                return compareAs(op, l.AsInt(), r.AsInt());
+            return compareAs(op, toDouble(l), toDouble(r));
+        }
+
+        /*
+            记录器：不在解释器里插桩，而是在寄存器 / globals 的副本上推演一次迭代。
+            只覆盖无副作用的指令子集 (常量、移动、全局读写、算术、比较、跳转)，
+            因此推演结果与解释器接下来真正执行的那一轮一致。
+        */
+        class TraceRecorder
+        {
+        private:
+            const Proto  &proto;
+            std::uint32_t header;
+            std::uint32_t backEdge;
+            std::size_t   globalCount;
+
+            DynArray<Value>   vars;
+            DynArray<TraceOp> ops;
+
+        public:
+            TraceRecorder(const Proto &p,
+                std::uint32_t          headerPc,
+                std::uint32_t          backEdgePc,
+                const Value           *registerBase,
+                const Value           *globals,
+                std::size_t            globals_) :
+                proto(p), header(headerPc), backEdge(backEdgePc), globalCount(globals_)
+            {
+                vars.resize(GlobalBase + globalCount);
+                for (std::uint32_t r = 0; r < proto.maxRegisters; ++r)
+                    vars[r] = registerBase[r];
+                for (std::size_t g = 0; g < globalCount; ++g)
+                    vars[GlobalBase + g] = globals[g];
+            }
+
+            const DynArray<TraceOp> &Ops() const
+            {
+                return ops;
+            }
+
+            std::size_t VarCount() const
+            {
+                return vars.size();
+            }
+
+            bool Record()
+            {
+                std::uint32_t pc = header;
+                while (ops.size() < TraceJit::MaxTraceLength)
+                {
+                    if (pc < header || pc > backEdge)
+                        return false; // 本轮离开了循环 (break / 循环结束)，下次再录
+
+                    Instruction   inst = proto.code[pc];
+                    OpCode        op   = static_cast<OpCode>(inst & 0xFF);
+                    std::uint8_t  a    = (inst >> 8) & 0xFF;
+                    std::uint8_t  b    = (inst >> 16) & 0xFF;
+                    std::uint8_t  c    = (inst >> 24) & 0xFF;
+                    std::uint16_t bx   = (inst >> 16) & 0xFFFF;
+                    std::int16_t  sbx  = static_cast<std::int16_t>(inst >> 16);
+                    std::int8_t   sc   = static_cast<std::int8_t>(inst >> 24);
+
+                    switch (op)
+                    {
+                        case OpCode::LoadK: load(pc, a, proto.constants[bx]); ++pc; continue;
+                        case OpCode::LoadTrue: load(pc, a, Value::GetTrueInstance()); ++pc; continue;
+                        case OpCode::LoadFalse: load(pc, a, Value::GetFalseInstance()); ++pc; continue;
+                        case OpCode::LoadNull: load(pc, a, Value::GetNullInstance()); ++pc; continue;
+
+                        case OpCode::Mov: move(pc, a, bx); ++pc; continue;
+                        case OpCode::GetGlobal:
+                            if (bx >= globalCount)
+                                return false;
+                            move(pc, a, GlobalBase + bx);
+                            ++pc;
+                            continue;
+                        case OpCode::SetGlobal:
+                            if (bx >= globalCount)
+                                return false;
+                            move(pc, GlobalBase + bx, a);
+                            ++pc;
+                            continue;
+
+                        case OpCode::Jmp: {
+                            std::uint32_t target = pc + 1 + sbx;
+                            if (sbx < 0)
+                                return target == header && !ops.empty(); // 回到循环头：记录完成
+                            pc = target;
+                            continue;
+                        }
+
+                        case OpCode::JmpIfFalse: {
+                            bool          truthy = vars[a].AsBool();
+                            std::uint32_t target = pc + 1 + sbx;
+
+                            TraceOp t{Kind::Branch, pc};
+                            t.lhs.var = a;
+                            t.expect  = truthy;
+                            t.exitPc  = truthy ? target : pc + 1;
+                            ops.push_back(t);
+
+                            pc = truthy ? pc + 1 : target;
+                            continue;
+                        }
+
+                        default: break;
+                    }
+
+                    ArithOp arith;
+                    CmpOp   cmp;
+                    Form    form;
+                    bool    intOnly;
+
+                    if (arithOf(op, arith, form, intOnly))
+                    {
+                        TraceOp t{Kind::Arith, pc};
+                        t.dst   = a;
+                        t.arith = arith;
+                        t.lhs   = regOperand(b);
+                        t.rhs   = rhsOperand(form, c);
+                        if (!observe(t, intOnly))
+                            return false;
+
+                        if (!simArith(arith, valueOf(t.lhs), valueOf(t.rhs), vars[a]))
+                            return false; // 本轮会溢出为 BigInt，下次再录
+                        ops.push_back(t);
+                        ++pc;
+                        continue;
+                    }
+
+                    if (compareOf(op, cmp, form, intOnly))
+                    {
+                        TraceOp t{Kind::Compare, pc};
+                        t.dst = a;
+                        t.cmp = cmp;
+                        t.lhs = regOperand(b);
+                        t.rhs = rhsOperand(form, c);
+                        if (!observe(t, intOnly))
+                            return false;
+
+                        vars[a] = Value::FromBool(simCompare(cmp, valueOf(t.lhs), valueOf(t.rhs)));
+                        ops.push_back(t);
+                        ++pc;
+                        continue;
+                    }
+
+                    if (fusedOf(op, cmp, form, intOnly))
+                    {
+                        TraceOp t{Kind::CmpBranch, pc};
+                        t.cmp = cmp;
+                        t.lhs = regOperand(a);
+                        t.rhs = rhsOperand(form, b);
+                        if (!observe(t, intOnly))
+                            return false;
+
+                        bool          cond   = simCompare(cmp, valueOf(t.lhs), valueOf(t.rhs));
+                        std::uint32_t target = pc + 1 + sc;
+                        t.expect             = cond;
+                        t.exitPc             = cond ? target : pc + 1;
+                        ops.push_back(t);
+
+                        pc = cond ? pc + 1 : target;
+                        continue;
+                    }
+
+                    // 调用 / 返回 / upvalue / 除法等：不录
+                    return false;
+                }
+                return false;
+            }
+
+        private:
+            void load(std::uint32_t pc, std::uint32_t dst, const Value &k)
+            {
+                TraceOp t{Kind::Load, pc};
+                t.dst         = dst;
+                t.lhs.isConst = true;
+                t.lhs.k       = k;
+                ops.push_back(t);
+                vars[dst] = k;
+            }
+
+            void move(std::uint32_t pc, std::uint32_t dst, std::uint32_t src)
+            {
+                TraceOp t{Kind::Move, pc};
+                t.dst     = dst;
+                t.lhs.var = src;
+                ops.push_back(t);
+                vars[dst] = vars[src];
+            }
+
+            static Operand regOperand(std::uint32_t r)
+            {
+                Operand o;
+                o.var = r;
+                return o;
+            }
+
+            Operand rhsOperand(Form form, std::uint8_t operand) const
+            {
+                Operand o;
+                switch (form)
+                {
+                    case Form::Reg: o.var = operand; break;
+                    case Form::Imm:
+                        o.isConst = true;
+                        o.k       = Value::FromInt(static_cast<std::int8_t>(operand));
+                        break;
+                    case Form::Const:
+                        o.isConst = true;
+                        o.k       = proto.constants[operand];
+                        break;
+                }
+                return o;
+            }
+
+            const Value &valueOf(const Operand &o) const
+            {
+                return o.isConst ? o.k : vars[o.var];
+            }
+
+            // 记下两个操作数的类型；非数值 (解释器会报错) 或 IntFast 指令见到非 Int 时放弃
+            bool observe(TraceOp &t, bool intOnly) const
+            {
+                t.lhsSeen = typeOf(valueOf(t.lhs));
+                t.rhsSeen = typeOf(valueOf(t.rhs));
+                if (!isNumeric(t.lhsSeen) || !isNumeric(t.rhsSeen))
+                    return false;
+                return !intOnly || (t.lhsSeen == VType::Int && t.rhsSeen == VType::Int);
+            }
+        };
+
+        /*
+            编译：寄存器约定同基线 JIT (R9 = registerBase, R10 = globals)。
+
+            循环体生成两遍：
+                peel: 变量类型全部未知，首次读到时按记录的类型插入守卫；
+                loop: 以 peel 结束时的类型状态为前提，守卫只剩分支方向。
+            loop 结束时的类型状态若与其入口一致则跳回 loop，否则回到 peel 重新守卫。
+            所有出口桩都是 `mov eax, pc; ret`。
+        */
+        class TraceCompiler
+        {
+        private:
+            const DynArray<TraceOp> &ops;
+            X64Emitter               as;
+            BaselineJit::ValueBits   bits;
+
+            DynArray<VType> types;
+
+            struct Fixup
+            {
+                std::size_t   at;
+                std::uint32_t pc;
+            };
+            DynArray<Fixup> exits;
+
+        public:
+            TraceCompiler(const DynArray<TraceOp> &o, std::size_t varCount) :
+                ops(o), bits(BaselineJit::Bits()), types(varCount, VType::Unknown)
+            {
+            }
+
+            X64Emitter &Emitter()
+            {
+                return as;
+            }
+
+            bool Compile()
+            {
+#if defined(_WIN32)
+                as.MovReg64(Reg::R9, Reg::RCX);
+                as.MovReg64(Reg::R10, Reg::RDX);
+#else
+                as.MovReg64(Reg::R9, Reg::RDI);
+                as.MovReg64(Reg::R10, Reg::RSI);
+#endif
+                std::size_t peelStart = as.Size();
+                if (!emitBody())
+                    return false;
+
+                DynArray<VType> loopEntry = types;
+                std::size_t     loopStart = as.Size();
+                if (!emitBody())
+                    return false;
+
+                bool stable = true;
+                for (std::size_t v = 0; v < types.size(); ++v)
+                {
+                    if (loopEntry[v] != VType::Unknown && types[v] != loopEntry[v])
+                    {
+                        stable = false;
+                        break;
+                    }
+                }
+                as.Bind(as.Jmp(), stable ? loopStart : peelStart);
+
+                std::unordered_map<std::uint32_t, std::size_t> stubs;
+                for (const Fixup &f : exits)
+                {
+                    auto it = stubs.find(f.pc);
+                    if (it == stubs.end())
+                    {
+                        it = stubs.emplace(f.pc, as.Size()).first;
+                        as.Byte(0xB8); // mov eax, imm32
+                        as.Dword(f.pc);
+                        as.Ret();
+                    }
+                    as.Bind(f.at, it->second);
+                }
+                return true;
+            }
+
+        private:
+            static std::int32_t disp(std::uint32_t var)
+            {
+                return static_cast<std::int32_t>((var < GlobalBase ? var : var - GlobalBase) * sizeof(Value));
+            }
+
+            static Reg baseOf(std::uint32_t var)
+            {
+                return var < GlobalBase ? Reg::R9 : Reg::R10;
+            }
+
+            void load64(Reg dst, std::uint32_t var)
+            {
+                as.MovLoad64(dst, baseOf(var), disp(var));
+            }
+
+            /*
+                Int 操作数的载荷左移 16 位装入 dst (常量直接装立即数)。
+                64 位运算与比较都在高 48 位上做，OF 即 48 位溢出
+            */
+            void loadShifted(Reg dst, const Operand &o)
+            {
+                if (o.isConst)
+                {
+                    as.MovImm64(dst, static_cast<std::uint64_t>(o.k.AsInt()) << 16);
+                    return;
+                }
+                load64(dst, o.var);
+                as.Shl64(dst, 16);
+            }
+
+            void store(std::uint32_t var, Reg src)
+            {
+                as.MovStore64(baseOf(var), disp(var), src);
+            }
+
+            void exitTo(std::size_t at, std::uint32_t pc)
+            {
+                exits.push_back({at, pc});
+            }
+
+            // 操作数类型：常量静态可知；变量未知时按记录插入守卫 (失败则从该指令重新解释)
+            bool typeOperand(const Operand &o, VType seen, std::uint32_t pc, VType &out)
+            {
+                if (o.isConst)
+                {
+                    out = typeOf(o.k);
+                    return isNumeric(out);
+                }
+                if (types[o.var] == VType::Unknown)
+                {
+                    load64(Reg::RAX, o.var);
+                    if (seen == VType::Int)
+                    {
+                        as.MovReg64(Reg::RDX, Reg::RAX);
+                        as.Shr64(Reg::RDX, 48);
+                        as.Alu32Imm(AluOp::Cmp, Reg::RDX, static_cast<std::int32_t>(bits.intTagHigh));
+                        exitTo(as.Jcc(Cond::NE), pc);
+                    }
+                    else
+                    {
+                        as.MovImm64(Reg::RDX, bits.qnanMask);
+                        as.Alu64(AluOp::And, Reg::RAX, Reg::RDX);
+                        as.Alu64(AluOp::Cmp, Reg::RAX, Reg::RDX);
+                        exitTo(as.Jcc(Cond::E), pc);
+                    }
+                    types[o.var] = seen;
+                }
+                out = types[o.var];
+                return isNumeric(out);
+            }
+
+            // 数值操作数装入 xmm (Int 转 double)
+            void toXmm(XmmReg dst, const Operand &o, VType t)
+            {
+                if (t == VType::Int)
+                {
+                    loadShifted(Reg::RAX, o);
+                    as.Sar64(Reg::RAX, 16);
+                    as.Cvtsi2sd64(dst, Reg::RAX);
+                    return;
+                }
+
+                if (o.isConst)
+                    as.MovImm64(Reg::RAX, o.k.Raw());
+                else
+                    load64(Reg::RAX, o.var);
+                as.MovqToXmm(dst, Reg::RAX);
+            }
+
+            // 比较两个数值操作数，返回条件成立时的条件码
+            bool emitCompare(const TraceOp &t, VType lt, VType rt, Cond &cond)
+            {
+                if (lt == VType::Int && rt == VType::Int)
+                {
+                    loadShifted(Reg::RAX, t.lhs);
+                    loadShifted(Reg::RCX, t.rhs);
+                    as.Alu64(AluOp::Cmp, Reg::RAX, Reg::RCX);
+                    switch (t.cmp)
+                    {
+                        case CmpOp::Eq: cond = Cond::E; break;
+                        case CmpOp::Ne: cond = Cond::NE; break;
+                        case CmpOp::Lt: cond = Cond::L; break;
+                        case CmpOp::Le: cond = Cond::LE; break;
+                        case CmpOp::Gt: cond = Cond::G; break;
+                        case CmpOp::Ge: cond = Cond::GE; break;
+                    }
+                    return true;
+                }
+
+                // double 的相等比较需要同时看 PF，少见，不编译
+                if (t.cmp == CmpOp::Eq || t.cmp == CmpOp::Ne)
+                    return false;
+
+                toXmm(XmmReg::XMM0, t.lhs, lt);
+                toXmm(XmmReg::XMM1, t.rhs, rt);
+                // 只用 A / AE (CF = 0)，无序 (NaN) 时恒为假，与 C++ 比较一致
+                if (t.cmp == CmpOp::Lt || t.cmp == CmpOp::Le)
+                    as.Ucomisd(XmmReg::XMM1, XmmReg::XMM0);
+                else
+                    as.Ucomisd(XmmReg::XMM0, XmmReg::XMM1);
+                cond = (t.cmp == CmpOp::Lt || t.cmp == CmpOp::Gt) ? Cond::A : Cond::AE;
+                return true;
+            }
+
+            bool emitArith(const TraceOp &t, VType lt, VType rt)
+            {
+                if (lt == VType::Int && rt == VType::Int)
+                {
+                    loadShifted(Reg::RAX, t.lhs);
+                    loadShifted(Reg::RCX, t.rhs);
+                    if (t.arith == ArithOp::Mul)
+                    {
+                        as.Sar64(Reg::RCX, 16); // (a << 16) * b
+                        as.Imul64(Reg::RAX, Reg::RCX);
+                    }
+                    else
+                    {
+                        as.Alu64(t.arith == ArithOp::Add ? AluOp::Add : AluOp::Sub, Reg::RAX, Reg::RCX);
+                    }
+                    // 溢出时从该指令重新解释，由解释器提升为 BigInt
+                    exitTo(as.Jcc(Cond::O), t.pc);
+                    as.Shr64(Reg::RAX, 16);
+                    as.MovImm64(Reg::RDX, bits.intTag);
+                    as.Alu64(AluOp::Or, Reg::RAX, Reg::RDX);
+                    store(t.dst, Reg::RAX);
+                    types[t.dst] = VType::Int;
+                    return true;
+                }
+
+                toXmm(XmmReg::XMM0, t.lhs, lt);
+                toXmm(XmmReg::XMM1, t.rhs, rt);
+                SseOp sse = t.arith == ArithOp::Add ? SseOp::Add : t.arith == ArithOp::Sub ? SseOp::Sub : SseOp::Mul;
+                as.SseArith(sse, XmmReg::XMM0, XmmReg::XMM1);
+                as.MovqFromXmm(Reg::RAX, XmmReg::XMM0);
+
+                // NaN 清洗，同 Value::FromDouble
+                as.MovImm64(Reg::RDX, bits.qnanMask);
+                as.MovReg64(Reg::R11, Reg::RAX);
+                as.Alu64(AluOp::And, Reg::R11, Reg::RDX);
+                as.Alu64(AluOp::Cmp, Reg::R11, Reg::RDX);
+                std::size_t ok = as.Jcc(Cond::NE);
+                as.MovReg64(Reg::RAX, Reg::RDX);
+                as.Bind(ok, as.Size());
+
+                store(t.dst, Reg::RAX);
+                types[t.dst] = VType::Double;
+                return true;
+            }
+
+            bool emitBody()
+            {
+                for (const TraceOp &t : ops)
+                {
+                    VType lt, rt;
+                    Cond  cond;
+                    switch (t.kind)
+                    {
+                        case Kind::Load:
+                            as.MovImm64(Reg::RAX, t.lhs.k.Raw());
+                            store(t.dst, Reg::RAX);
+                            types[t.dst] = typeOf(t.lhs.k);
+                            break;
+
+                        case Kind::Move:
+                            load64(Reg::RAX, t.lhs.var);
+                            store(t.dst, Reg::RAX);
+                            types[t.dst] = types[t.lhs.var];
+                            break;
+
+                        case Kind::Arith:
+                            if (!typeOperand(t.lhs, t.lhsSeen, t.pc, lt) || !typeOperand(t.rhs, t.rhsSeen, t.pc, rt))
+                                return false;
+                            if (!emitArith(t, lt, rt))
+                                return false;
+                            break;
+
+                        case Kind::Compare:
+                            if (!typeOperand(t.lhs, t.lhsSeen, t.pc, lt) || !typeOperand(t.rhs, t.rhsSeen, t.pc, rt))
+                                return false;
+                            if (!emitCompare(t, lt, rt, cond))
+                                return false;
+                            as.SetccEax(cond);
+                            as.MovImm64(Reg::RDX, bits.falseBits); // TAG_TRUE = TAG_FALSE | 1
+                            as.Alu64(AluOp::Or, Reg::RAX, Reg::RDX);
+                            store(t.dst, Reg::RAX);
+                            types[t.dst] = VType::Bool;
+                            break;
+
+                        case Kind::Branch:
+                            load64(Reg::RAX, t.lhs.var);
+                            as.MovImm64(Reg::RCX, bits.trueBits);
+                            as.Alu64(AluOp::Cmp, Reg::RAX, Reg::RCX);
+                            exitTo(as.Jcc(t.expect ? Cond::NE : Cond::E), t.exitPc);
+                            break;
+
+                        case Kind::CmpBranch:
+                            if (!typeOperand(t.lhs, t.lhsSeen, t.pc, lt) || !typeOperand(t.rhs, t.rhsSeen, t.pc, rt))
+                                return false;
+                            if (!emitCompare(t, lt, rt, cond))
+                                return false;
+                            exitTo(as.Jcc(t.expect ? Invert(cond) : cond), t.exitPc);
+                            break;
+                    }
+                }
+                return true;
+            }
+        };
+    } // namespace
+
+    Trace *TraceJit::Record(const Proto *proto,
+        std::uint32_t                    headerPc,
+        std::uint32_t                    backEdgePc,
+        const Value                     *registerBase,
+        const Value                     *globals,
+        std::size_t                      globalCount)
+    {
+        TraceRecorder recorder(*proto, headerPc, backEdgePc, registerBase, globals, globalCount);
+        if (!recorder.Record())
+            return nullptr;
+
+        TraceCompiler compiler(recorder.Ops(), recorder.VarCount());
+        if (!compiler.Compile())
+            return nullptr;
+
+        X64Emitter &as    = compiler.Emitter();
+        auto        trace = std::make_unique<Trace>();
+        if (!trace->memory.Allocate(as.Size()))
+            return nullptr;
+
+        std::memcpy(trace->memory.Data(), as.code.data(), as.Size());
+        if (!trace->memory.Seal())
+            return nullptr;
+
+        trace->entry    = reinterpret_cast<TraceFn>(trace->memory.Data());
+        trace->headerPc = headerPc;
+        trace->length   = static_cast<std::uint32_t>(recorder.Ops().size());
+        traces.push_back(std::move(trace));
+        return traces.back().get();
+    }
+
+#else
+
+    Trace *TraceJit::Record(const Proto *, std::uint32_t, std::uint32_t, const Value *, const Value *, std::size_t)
+    {
+        return nullptr;
+    }
+
+#endif
+} // namespace Fig::Jit
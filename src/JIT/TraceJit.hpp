@@ -0,0 +1,61 @@
+/*!
+    @file src/JIT/TraceJit.hpp
+    @brief 追踪 JIT：记录热循环的一次迭代，按观测到的类型特化为带守卫的线性机器码
+*/
+
+#pragma once
+
+#include <Bytecode/Bytecode.hpp>
+#include <JIT/BaselineJit.hpp>
+#include <JIT/ExecutableMemory.hpp>
+
+#include <memory>
+
+namespace Fig::Jit
+{
+    /*
+        trace 入口：从循环头开始反复执行循环体，直到某个守卫失败 (侧出口)，
+        返回解释器应当接着执行的 pc。
+
+        trace 内的每次写回都直接落到寄存器栈 / globals，侧出口时寄存器文件已经是
+        解释器在该 pc 处应看到的状态，无需额外恢复。
+    */
+    using TraceFn = std::uint32_t (*)(Value *registerBase, Value *globals);
+
+    struct Trace
+    {
+        ExecutableMemory memory;
+        TraceFn          entry    = nullptr;
+        std::uint32_t    headerPc = 0;
+        std::uint32_t    length   = 0; // 记录到的指令数
+    };
+
+    class TraceJit
+    {
+    private:
+        DynArray<std::unique_ptr<Trace>> traces;
+
+    public:
+        static constexpr std::uint32_t MaxTraceLength = 1024;
+
+        // 同一循环头记录失败这么多次后不再尝试
+        static constexpr std::uint16_t MaxAborts = 4;
+
+        /*
+            以当前寄存器 / globals 为输入，在副本上推演 [headerPc, backEdgePc] 的一次迭代，
+            记录指令、操作数类型与分支方向后编译。推演本身没有副作用。
+            遇到未覆盖的指令、内层循环、离开循环或平台不支持时返回 nullptr
+        */
+        Trace *Record(const Proto *proto,
+            std::uint32_t          headerPc,
+            std::uint32_t          backEdgePc,
+            const Value           *registerBase,
+            const Value           *globals,
+            std::size_t            globalCount);
+
+        std::size_t TraceCount() const
+        {
+            return traces.size();
+        }
+    };
+} // namespace Fig::Jit
@@ -0,0 +1,418 @@
+/*!
+    @file src/JIT/X64Emitter.hpp
+    @brief 极简 x86-64 指令编码器：只覆盖基线 JIT / 追踪 JIT 用到的指令形式
+*/
+
+#pragma once
+
+#include <Deps/Deps.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace Fig::Jit
+{
+    enum class Reg : std::uint8_t
+    {
+        RAX = 0,
+        RCX,
+        RDX,
+        RBX,
+        RSP,
+        RBP,
+        RSI,
+        RDI,
+        R8,
+        R9,
+        R10,
+        R11,
+    };
+
+    enum class XmmReg : std::uint8_t
+    {
+        XMM0 = 0,
+        XMM1,
+    };
+
+    // Jcc / SETcc 的条件码 (低 4 位)
+    enum class Cond : std::uint8_t
+    {
+        O  = 0x0,
+        NO = 0x1,
+        B  = 0x2,
+        AE = 0x3,
+        E  = 0x4,
+        NE = 0x5,
+        BE = 0x6,
+        A  = 0x7,
+        P  = 0xA,
+        NP = 0xB,
+        L  = 0xC,
+        GE = 0xD,
+        LE = 0xE,
+        G  = 0xF,
+    };
+
+    inline Cond Invert(Cond c)
+    {
+        return static_cast<Cond>(static_cast<std::uint8_t>(c) ^ 1);
+    }
+
+    enum class AluOp : std::uint8_t
+    {
+        Add,
+        Sub,
+        Cmp,
+        Or,
+        And,
+    };
+
+    // F2 0F xx 标量双精度运算
+    enum class SseOp : std::uint8_t
+    {
+        Add = 0x58,
+        Mul = 0x59,
+        Sub = 0x5C,
+    };
+
+    /*
+        内存操作数统一为 [base + disp32]，base 不使用 RSP/R12 (免 SIB)。
+        所有 rel32 跳转返回 rel32 字段的偏移，由调用方在代码定稿后回填。
+    */
+    class X64Emitter
+    {
+    public:
+        DynArray<std::uint8_t> code;
+
+        std::size_t Size() const
+        {
+            return code.size();
+        }
+
+        void Byte(std::uint8_t b)
+        {
+            code.push_back(b);
+        }
+
+        void Dword(std::uint32_t v)
+        {
+            for (int i = 0; i < 4; ++i)
+                Byte(static_cast<std::uint8_t>(v >> (i * 8)));
+        }
+
+        void Qword(std::uint64_t v)
+        {
+            for (int i = 0; i < 8; ++i)
+                Byte(static_cast<std::uint8_t>(v >> (i * 8)));
+        }
+
+        void PatchDword(std::size_t at, std::uint32_t v)
+        {
+            std::memcpy(code.data() + at, &v, 4);
+        }
+
+        void PatchQword(std::size_t at, std::uint64_t v)
+        {
+            std::memcpy(code.data() + at, &v, 8);
+        }
+
+        // mov r64, [base + disp]
+        void MovLoad64(Reg dst, Reg base, std::int32_t disp)
+        {
+            rex(true, dst, base);
+            Byte(0x8B);
+            modrmDisp(dst, base, disp);
+        }
+
+        // mov r32, [base + disp] (高 32 位清零)
+        void MovLoad32(Reg dst, Reg base, std::int32_t disp)
+        {
+            rexIfNeeded(dst, base);
+            Byte(0x8B);
+            modrmDisp(dst, base, disp);
+        }
+
+        // mov [base + disp], r64
+        void MovStore64(Reg base, std::int32_t disp, Reg src)
+        {
+            rex(true, src, base);
+            Byte(0x89);
+            modrmDisp(src, base, disp);
+        }
+
+        // mov r64, imm64
+        std::size_t MovImm64(Reg dst, std::uint64_t imm)
+        {
+            Byte(static_cast<std::uint8_t>(0x48 | (hi(dst) ? 0x01 : 0)));
+            Byte(static_cast<std::uint8_t>(0xB8 + lo(dst)));
+            std::size_t at = Size();
+            Qword(imm);
+            return at;
+        }
+
+        // mov r64, r64
+        void MovReg64(Reg dst, Reg src)
+        {
+            rex(true, src, dst);
+            Byte(0x89);
+            modrmReg(src, dst);
+        }
+
+        // mov r32, r32 (高 32 位清零)
+        void MovReg32(Reg dst, Reg src)
+        {
+            rexIfNeeded(src, dst);
+            Byte(0x89);
+            modrmReg(src, dst);
+        }
+
+        // add/sub/cmp/or/and r/m32, r32
+        void Alu32(AluOp op, Reg dst, Reg src)
+        {
+            rexIfNeeded(src, dst);
+            Byte(aluOpcode(op));
+            modrmReg(src, dst);
+        }
+
+        // add/sub/cmp/or/and r/m64, r64
+        void Alu64(AluOp op, Reg dst, Reg src)
+        {
+            rex(true, src, dst);
+            Byte(aluOpcode(op));
+            modrmReg(src, dst);
+        }
+
+        // add/sub/cmp/or/and r32, imm32
+        void Alu32Imm(AluOp op, Reg dst, std::int32_t imm)
+        {
+            rexIfNeeded(Reg::RAX, dst);
+            Byte(0x81);
+            modrmReg(static_cast<Reg>(aluExt(op)), dst);
+            Dword(static_cast<std::uint32_t>(imm));
+        }
+
+        // imul r32, r/m32
+        void Imul32(Reg dst, Reg src)
+        {
+            rexIfNeeded(dst, src);
+            Byte(0x0F);
+            Byte(0xAF);
+            modrmReg(dst, src);
+        }
+
+        // imul r64, r/m64
+        void Imul64(Reg dst, Reg src)
+        {
+            rex(true, dst, src);
+            Byte(0x0F);
+            Byte(0xAF);
+            modrmReg(dst, src);
+        }
+
+        // imul r32, r/m32, imm32
+        void Imul32Imm(Reg dst, Reg src, std::int32_t imm)
+        {
+            rexIfNeeded(dst, src);
+            Byte(0x69);
+            modrmReg(dst, src);
+            Dword(static_cast<std::uint32_t>(imm));
+        }
+
+        // shr r64, imm8
+        void Shr64(Reg dst, std::uint8_t imm)
+        {
+            rex(true, Reg::RAX, dst);
+            Byte(0xC1);
+            modrmReg(static_cast<Reg>(5), dst);
+            Byte(imm);
+        }
+
+        // shl r64, imm8
+        void Shl64(Reg dst, std::uint8_t imm)
+        {
+            rex(true, Reg::RAX, dst);
+            Byte(0xC1);
+            modrmReg(static_cast<Reg>(4), dst);
+            Byte(imm);
+        }
+
+        // sar r64, imm8
+        void Sar64(Reg dst, std::uint8_t imm)
+        {
+            rex(true, Reg::RAX, dst);
+            Byte(0xC1);
+            modrmReg(static_cast<Reg>(7), dst);
+            Byte(imm);
+        }
+
+        // setcc al; movzx eax, al
+        void SetccEax(Cond c)
+        {
+            Byte(0x0F);
+            Byte(static_cast<std::uint8_t>(0x90 | static_cast<std::uint8_t>(c)));
+            Byte(0xC0);
+            Byte(0x0F);
+            Byte(0xB6);
+            Byte(0xC0);
+        }
+
+        // movq xmm, r64
+        void MovqToXmm(XmmReg dst, Reg src)
+        {
+            Byte(0x66);
+            Byte(static_cast<std::uint8_t>(0x48 | (hi(src) ? 0x01 : 0)));
+            Byte(0x0F);
+            Byte(0x6E);
+            Byte(static_cast<std::uint8_t>(0xC0 | (static_cast<std::uint8_t>(dst) << 3) | lo(src)));
+        }
+
+        // movq r64, xmm
+        void MovqFromXmm(Reg dst, XmmReg src)
+        {
+            Byte(0x66);
+            Byte(static_cast<std::uint8_t>(0x48 | (hi(dst) ? 0x01 : 0)));
+            Byte(0x0F);
+            Byte(0x7E);
+            Byte(static_cast<std::uint8_t>(0xC0 | (static_cast<std::uint8_t>(src) << 3) | lo(dst)));
+        }
+
+        // addsd / subsd / mulsd xmm, xmm
+        void SseArith(SseOp op, XmmReg dst, XmmReg src)
+        {
+            Byte(0xF2);
+            Byte(0x0F);
+            Byte(static_cast<std::uint8_t>(op));
+            Byte(static_cast<std::uint8_t>(
+                0xC0 | (static_cast<std::uint8_t>(dst) << 3) | static_cast<std::uint8_t>(src)));
+        }
+
+        // cvtsi2sd xmm, r32
+        void Cvtsi2sd32(XmmReg dst, Reg src)
+        {
+            Byte(0xF2);
+            rexIfNeeded(Reg::RAX, src);
+            Byte(0x0F);
+            Byte(0x2A);
+            Byte(static_cast<std::uint8_t>(0xC0 | (static_cast<std::uint8_t>(dst) << 3) | lo(src)));
+        }
+
+        // cvtsi2sd xmm, r64
+        void Cvtsi2sd64(XmmReg dst, Reg src)
+        {
+            Byte(0xF2);
+            rex(true, Reg::RAX, src);
+            Byte(0x0F);
+            Byte(0x2A);
+            Byte(static_cast<std::uint8_t>(0xC0 | (static_cast<std::uint8_t>(dst) << 3) | lo(src)));
+        }
+
+        // ucomisd xmm, xmm (按 lhs - rhs 设置 ZF/PF/CF，无序时三者全为 1)
+        void Ucomisd(XmmReg lhs, XmmReg rhs)
+        {
+            Byte(0x66);
+            Byte(0x0F);
+            Byte(0x2E);
+            Byte(static_cast<std::uint8_t>(
+                0xC0 | (static_cast<std::uint8_t>(lhs) << 3) | static_cast<std::uint8_t>(rhs)));
+        }
+
+        // jcc rel32，返回 rel32 字段偏移
+        std::size_t Jcc(Cond c)
+        {
+            Byte(0x0F);
+            Byte(static_cast<std::uint8_t>(0x80 | static_cast<std::uint8_t>(c)));
+            std::size_t at = Size();
+            Dword(0);
+            return at;
+        }
+
+        // jmp rel32，返回 rel32 字段偏移
+        std::size_t Jmp()
+        {
+            Byte(0xE9);
+            std::size_t at = Size();
+            Dword(0);
+            return at;
+        }
+
+        // jmp qword [table + index * 8]
+        void JmpTable(Reg table, Reg index)
+        {
+            Byte(static_cast<std::uint8_t>(0x40 | (hi(index) ? 0x02 : 0) | (hi(table) ? 0x01 : 0)));
+            Byte(0xFF);
+            Byte(0x24); // mod=00, reg=/4, rm=SIB
+            Byte(static_cast<std::uint8_t>((3 << 6) | (lo(index) << 3) | lo(table)));
+        }
+
+        void Ret()
+        {
+            Byte(0xC3);
+        }
+
+        // rel32 字段 at 指向 target 偏移
+        void Bind(std::size_t at, std::size_t target)
+        {
+            PatchDword(at, static_cast<std::uint32_t>(
+                               static_cast<std::int64_t>(target) - static_cast<std::int64_t>(at + 4)));
+        }
+
+    private:
+        static bool hi(Reg r)
+        {
+            return static_cast<std::uint8_t>(r) >= 8;
+        }
+        static std::uint8_t lo(Reg r)
+        {
+            return static_cast<std::uint8_t>(r) & 7;
+        }
+
+        void rex(bool w, Reg reg, Reg rm)
+        {
+            Byte(static_cast<std::uint8_t>(
+                0x40 | (w ? 0x08 : 0) | (hi(reg) ? 0x04 : 0) | (hi(rm) ? 0x01 : 0)));
+        }
+
+        void rexIfNeeded(Reg reg, Reg rm)
+        {
+            if (hi(reg) || hi(rm))
+                rex(false, reg, rm);
+        }
+
+        void modrmReg(Reg reg, Reg rm)
+        {
+            Byte(static_cast<std::uint8_t>(0xC0 | (lo(reg) << 3) | lo(rm)));
+        }
+
+        void modrmDisp(Reg reg, Reg base, std::int32_t disp)
+        {
+            Byte(static_cast<std::uint8_t>(0x80 | (lo(reg) << 3) | lo(base))); // mod=10: disp32
+            Dword(static_cast<std::uint32_t>(disp));
+        }
+
+        static std::uint8_t aluOpcode(AluOp op)
+        {
+            switch (op)
+            {
+                case AluOp::Add: return 0x01;
+                case AluOp::Sub: return 0x29;
+                case AluOp::Cmp: return 0x39;
+                case AluOp::Or: return 0x09;
+                case AluOp::And: return 0x21;
+            }
+            return 0x01;
+        }
+
+        static std::uint8_t aluExt(AluOp op)
+        {
+            switch (op)
+            {
+                case AluOp::Add: return 0;
+                case AluOp::Or: return 1;
+                case AluOp::And: return 4;
+                case AluOp::Sub: return 5;
+                case AluOp::Cmp: return 7;
+            }
+            return 0;
+        }
+    };
+} // namespace Fig::Jit
@@ -0,0 +1,471 @@
+/*!
+    @file src/Object/BigInt.cpp
+    @brief 任意精度整数实现：加减、学校乘法 / Karatsuba、Knuth D 除法与十进制格式化
+*/
+
+#include <Object/BigInt.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <string>
+
+namespace Fig
+{
+    namespace
+    {
+        using Limb   = BigInt::Limb;
+        using Mag    = DynArray<Limb>;
+        using View   = std::span<const Limb>;
+        using Wide   = std::uint64_t;
+        using SWide  = std::int64_t;
+
+        constexpr unsigned LimbBits = 32;
+
+        View trimmed(View v)
+        {
+            while (!v.empty() && v.back() == 0)
+                v = v.first(v.size() - 1);
+            return v;
+        }
+
+        void trimMag(Mag &m)
+        {
+            while (!m.empty() && m.back() == 0)
+                m.pop_back();
+        }
+
+        int compareMag(View a, View b)
+        {
+            if (a.size() != b.size())
+                return a.size() < b.size() ? -1 : 1;
+            for (std::size_t i = a.size(); i-- > 0;)
+            {
+                if (a[i] != b[i])
+                    return a[i] < b[i] ? -1 : 1;
+            }
+            return 0;
+        }
+
+        Mag addMag(View a, View b)
+        {
+            if (a.size() < b.size())
+                std::swap(a, b);
+            Mag  r(a.size() + 1);
+            Wide carry = 0;
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                Wide s = Wide{a[i]} + (i < b.size() ? b[i] : 0) + carry;
+                r[i]   = static_cast<Limb>(s);
+                carry  = s >> LimbBits;
+            }
+            r[a.size()] = static_cast<Limb>(carry);
+            trimMag(r);
+            return r;
+        }
+
+        // r -= b，要求 r >= b (按绝对值)
+        void subInPlace(Mag &r, View b)
+        {
+            Limb borrow = 0;
+            for (std::size_t i = 0; i < r.size(); ++i)
+            {
+                Wide sub = Wide{i < b.size() ? b[i] : 0} + borrow;
+                if (sub == 0 && i >= b.size())
+                    break;
+                borrow = Wide{r[i]} < sub ? 1 : 0;
+                r[i]   = static_cast<Limb>(Wide{r[i]} - sub);
+            }
+            trimMag(r);
+        }
+
+        // r[shift..] += x，r 须足够长
+        void addShifted(Mag &r, View x, std::size_t shift)
+        {
+            Wide        carry = 0;
+            std::size_t i     = 0;
+            for (; i < x.size(); ++i)
+            {
+                Wide s           = Wide{r[i + shift]} + x[i] + carry;
+                r[i + shift]     = static_cast<Limb>(s);
+                carry            = s >> LimbBits;
+            }
+            for (std::size_t k = i + shift; carry != 0; ++k)
+            {
+                Wide s = Wide{r[k]} + carry;
+                r[k]   = static_cast<Limb>(s);
+                carry  = s >> LimbBits;
+            }
+        }
+
+        Mag mulSchool(View a, View b)
+        {
+            Mag r(a.size() + b.size(), 0);
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                Wide carry = 0;
+                for (std::size_t j = 0; j < b.size(); ++j)
+                {
+                    Wide t   = Wide{a[i]} * b[j] + r[i + j] + carry;
+                    r[i + j] = static_cast<Limb>(t);
+                    carry    = t >> LimbBits;
+                }
+                r[i + b.size()] = static_cast<Limb>(carry);
+            }
+            trimMag(r);
+            return r;
+        }
+
+        /*
+            Karatsuba：a = a1·B^m + a0，b = b1·B^m + b0，
+            a·b = z2·B^2m + (z1 - z2 - z0)·B^m + z0，其中 z1 = (a0 + a1)(b0 + b1)。
+            较短的一边放不满低半部分时按 m 切成块逐块相乘
+        */
+        Mag mulMag(View a, View b)
+        {
+            a = trimmed(a);
+            b = trimmed(b);
+            if (a.empty() || b.empty())
+                return {};
+            if (a.size() < b.size())
+                std::swap(a, b);
+            if (b.size() < BigInt::KaratsubaThreshold)
+                return mulSchool(a, b);
+
+            std::size_t m = a.size() / 2;
+            Mag         r(a.size() + b.size() + 1, 0);
+            if (b.size() <= m)
+            {
+                for (std::size_t off = 0; off < a.size(); off += b.size())
+                {
+                    View chunk = a.subspan(off, std::min(b.size(), a.size() - off));
+                    addShifted(r, mulMag(chunk, b), off);
+                }
+                trimMag(r);
+                return r;
+            }
+
+            View a0 = a.first(m), a1 = a.subspan(m);
+            View b0 = b.first(m), b1 = b.subspan(m);
+            Mag  z0 = mulMag(a0, b0);
+            Mag  z2 = mulMag(a1, b1);
+            Mag  z1 = mulMag(addMag(trimmed(a0), a1), addMag(trimmed(b0), b1));
+            subInPlace(z1, z0);
+            subInPlace(z1, z2);
+
+            addShifted(r, z0, 0);
+            addShifted(r, z1, m);
+            addShifted(r, z2, 2 * m);
+            trimMag(r);
+            return r;
+        }
+
+        // 除以单个 limb，返回余数
+        Limb divModSmall(View u, Limb d, Mag &q)
+        {
+            q.assign(u.size(), 0);
+            Wide rem = 0;
+            for (std::size_t i = u.size(); i-- > 0;)
+            {
+                Wide cur = (rem << LimbBits) | u[i];
+                q[i]     = static_cast<Limb>(cur / d);
+                rem      = cur % d;
+            }
+            trimMag(q);
+            return static_cast<Limb>(rem);
+        }
+
+        /*
+            Knuth 算法 D (TAOCP 4.3.1)：除数规格化到最高位为 1，每步用前两位估商再至多修正两次。
+            要求 v 至少两个 limb 且 |u| >= |v|
+        */
+        void divModMag(View u, View v, Mag &q, Mag &r)
+        {
+            std::size_t n = v.size();
+            std::size_t m = u.size() - n;
+            unsigned    s = static_cast<unsigned>(std::countl_zero(v[n - 1]));
+
+            auto shl = [s](Limb hi, Limb lo) -> Limb {
+                return s == 0 ? hi : static_cast<Limb>((hi << s) | (lo >> (LimbBits - s)));
+            };
+
+            Mag vn(n), un(u.size() + 1);
+            for (std::size_t i = n; i-- > 1;)
+                vn[i] = shl(v[i], v[i - 1]);
+            vn[0] = shl(v[0], 0);
+            un[u.size()] = s == 0 ? 0 : static_cast<Limb>(u[u.size() - 1] >> (LimbBits - s));
+            for (std::size_t i = u.size(); i-- > 1;)
+                un[i] = shl(u[i], u[i - 1]);
+            un[0] = shl(u[0], 0);
+
+            constexpr Wide Base = Wide{1} << LimbBits;
+            q.assign(m + 1, 0);
+            for (std::size_t j = m + 1; j-- > 0;)
+            {
+                Wide num  = (Wide{un[j + n]} << LimbBits) | un[j + n - 1];
+                Wide qhat = num / vn[n - 1];
+                Wide rhat = num % vn[n - 1];
+                while (qhat >= Base || qhat * vn[n - 2] > ((rhat << LimbBits) | un[j + n - 2]))
+                {
+                    --qhat;
+                    rhat += vn[n - 1];
+                    if (rhat >= Base)
+                        break;
+                }
+
+                // un[j..j+n] -= qhat * vn
+                SWide borrow = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    Wide  p  = qhat * vn[i];
+                    SWide t  = SWide{un[i + j]} - borrow - static_cast<SWide>(p & 0xFFFFFFFFu);
+                    un[i + j] = static_cast<Limb>(t);
+                    borrow   = static_cast<SWide>(p >> LimbBits) - (t >> LimbBits);
+                }
+                SWide t   = SWide{un[j + n]} - borrow;
+                un[j + n] = static_cast<Limb>(t);
+
+                q[j] = static_cast<Limb>(qhat);
+                if (t < 0)
+                {
+                    // 估大了一，加回一个除数
+                    --q[j];
+                    Wide carry = 0;
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        Wide sum  = Wide{un[i + j]} + vn[i] + carry;
+                        un[i + j] = static_cast<Limb>(sum);
+                        carry     = sum >> LimbBits;
+                    }
+                    un[j + n] = static_cast<Limb>(un[j + n] + carry);
+                }
+            }
+
+            r.assign(n, 0);
+            for (std::size_t i = 0; i < n; ++i)
+                r[i] = s == 0 ? un[i] : static_cast<Limb>((un[i] >> s) | (un[i + 1] << (LimbBits - s)));
+            trimMag(q);
+            trimMag(r);
+        }
+
+        // m = m * mul + add
+        void mulAddSmall(Mag &m, Limb mul, Limb add)
+        {
+            Wide carry = add;
+            for (Limb &limb : m)
+            {
+                Wide t = Wide{limb} * mul + carry;
+                limb   = static_cast<Limb>(t);
+                carry  = t >> LimbBits;
+            }
+            if (carry)
+                m.push_back(static_cast<Limb>(carry));
+        }
+    } // namespace
+
+    BigInt BigInt::FromInt(std::int64_t v)
+    {
+        Wide abs = v < 0 ? Wide{0} - static_cast<Wide>(v) : static_cast<Wide>(v);
+        return BigInt(Mag{static_cast<Limb>(abs), static_cast<Limb>(abs >> LimbBits)}, v < 0);
+    }
+
+    BigInt BigInt::FromLimbs(std::span<const Limb> limbs, bool negative)
+    {
+        return BigInt(Mag(limbs.begin(), limbs.end()), negative);
+    }
+
+    std::optional<BigInt> BigInt::Parse(std::string_view digits, int base)
+    {
+        if (digits.empty())
+            return std::nullopt;
+
+        Mag m;
+        if (base == 10)
+        {
+            // 每 9 位一组：m = m * 10^9 + chunk
+            std::size_t head = digits.size() % 9;
+            for (std::size_t pos = 0; pos < digits.size(); head = 9)
+            {
+                std::size_t len   = head == 0 ? 9 : head;
+                Limb        chunk = 0, scale = 1;
+                for (char c : digits.substr(pos, len))
+                {
+                    if (c < '0' || c > '9')
+                        return std::nullopt;
+                    chunk = chunk * 10 + static_cast<Limb>(c - '0');
+                    scale *= 10;
+                }
+                mulAddSmall(m, scale, chunk);
+                pos += len;
+            }
+        }
+        else
+        {
+            for (char c : digits)
+            {
+                int d = c >= '0' && c <= '9'   ? c - '0'
+                        : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                        : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                                               : base;
+                if (d >= base)
+                    return std::nullopt;
+                mulAddSmall(m, static_cast<Limb>(base), static_cast<Limb>(d));
+            }
+        }
+        return BigInt(std::move(m), false);
+    }
+
+    bool BigInt::ToInt64(std::int64_t &out) const
+    {
+        if (mag.size() > 2)
+            return false;
+        Wide abs = 0;
+        for (std::size_t i = mag.size(); i-- > 0;)
+            abs = (abs << LimbBits) | mag[i];
+
+        constexpr Wide Limit = Wide{1} << 63;
+        if (negative ? abs > Limit : abs >= Limit)
+            return false;
+        out = negative ? static_cast<std::int64_t>(Wide{0} - abs) : static_cast<std::int64_t>(abs);
+        return true;
+    }
+
+    double BigInt::ToDouble() const
+    {
+        if (mag.empty())
+            return 0.0;
+
+        // 取最高 64 位，更低的位只留一个粘滞位：64 > 53 + 2，一次转换即可正确舍入
+        std::size_t bits = mag.size() * LimbBits - static_cast<std::size_t>(std::countl_zero(mag.back()));
+        Wide        top  = 0;
+        bool        sticky;
+        if (bits <= 64)
+        {
+            for (std::size_t i = mag.size(); i-- > 0;)
+                top = (top << LimbBits) | mag[i];
+            sticky = false;
+            bits   = 64;
+        }
+        else
+        {
+            std::size_t low  = bits - 64; // 丢掉的低位数
+            std::size_t word = low / LimbBits;
+            unsigned    sh   = static_cast<unsigned>(low % LimbBits);
+            for (std::size_t i = std::min(word + 2, mag.size() - 1) + 1; i-- > word;)
+            {
+                Wide limb = mag[i];
+                std::size_t pos = (i - word) * LimbBits; // limb 在 (value >> word*32) 中的位置
+                if (pos >= sh)
+                {
+                    if (pos - sh < 64)
+                        top |= limb << (pos - sh);
+                }
+                else
+                {
+                    top |= limb >> (sh - pos);
+                }
+            }
+            sticky = sh != 0 && (mag[word] & ((Limb{1} << sh) - 1)) != 0;
+            for (std::size_t i = 0; i < word && !sticky; ++i)
+                sticky = mag[i] != 0;
+        }
+
+        double d = std::ldexp(static_cast<double>(top | (sticky ? 1 : 0)), static_cast<int>(bits) - 64);
+        return negative ? -d : d;
+    }
+
+    String BigInt::ToString() const
+    {
+        if (mag.empty())
+            return "0";
+
+        // 反复除以 10^9，每组 9 位十进制
+        constexpr Limb       ChunkBase = 1000000000;
+        DynArray<Limb>       chunks;
+        Mag                  cur = mag, next;
+        while (!cur.empty())
+        {
+            chunks.push_back(divModSmall(cur, ChunkBase, next));
+            cur.swap(next);
+        }
+
+        std::string out = negative ? "-" : "";
+        out += std::to_string(chunks.back());
+        for (std::size_t i = chunks.size() - 1; i-- > 0;)
+        {
+            std::string part = std::to_string(chunks[i]);
+            out.append(9 - part.size(), '0');
+            out += part;
+        }
+        return out;
+    }
+
+    BigInt BigInt::operator-() const
+    {
+        return BigInt(mag, !negative);
+    }
+
+    BigInt BigInt::addSigned(const BigInt &a, const BigInt &b, bool negateB)
+    {
+        bool bNeg = b.negative != negateB;
+        if (a.negative == bNeg)
+            return BigInt(addMag(a.mag, b.mag), a.negative);
+
+        // 异号：大减小，符号随绝对值大的一边
+        if (compareMag(a.mag, b.mag) >= 0)
+        {
+            Mag r = a.mag;
+            subInPlace(r, b.mag);
+            return BigInt(std::move(r), a.negative);
+        }
+        Mag r = b.mag;
+        subInPlace(r, a.mag);
+        return BigInt(std::move(r), bNeg);
+    }
+
+    BigInt operator+(const BigInt &a, const BigInt &b)
+    {
+        return BigInt::addSigned(a, b, false);
+    }
+
+    BigInt operator-(const BigInt &a, const BigInt &b)
+    {
+        return BigInt::addSigned(a, b, true);
+    }
+
+    BigInt operator*(const BigInt &a, const BigInt &b)
+    {
+        return BigInt(mulMag(a.mag, b.mag), a.negative != b.negative);
+    }
+
+    void BigInt::DivMod(const BigInt &a, const BigInt &b, BigInt &quot, BigInt &rem)
+    {
+        Mag q, r;
+        if (compareMag(a.mag, b.mag) < 0)
+        {
+            r = a.mag;
+        }
+        else if (b.mag.size() == 1)
+        {
+            Limb small = divModSmall(a.mag, b.mag[0], q);
+            if (small)
+                r.push_back(small);
+        }
+        else
+        {
+            divModMag(a.mag, b.mag, q, r);
+        }
+        quot = BigInt(std::move(q), a.negative != b.negative);
+        rem  = BigInt(std::move(r), a.negative);
+    }
+
+    std::strong_ordering operator<=>(const BigInt &a, const BigInt &b)
+    {
+        if (a.negative != b.negative)
+            return a.negative ? std::strong_ordering::less : std::strong_ordering::greater;
+        int c = compareMag(a.mag, b.mag);
+        if (a.negative)
+            c = -c;
+        return c <=> 0;
+    }
+} // namespace Fig
@@ -0,0 +1,93 @@
+/*!
+    @file src/Object/BigInt.hpp
+    @brief 任意精度整数：符号 + 32 位 limb 数组的值类型，VM 在 Int 溢出时用它计算再装进 BigIntObject
+*/
+
+#pragma once
+
+#include <Deps/Deps.hpp>
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace Fig
+{
+    /*
+        绝对值按 limb 小端存放，不留前导零 (0 为空数组，且不为负)。
+        运算都是纯计算不碰 GC 堆：VM 先算出结果，再一次性分配对象拷贝 limb
+    */
+    class BigInt
+    {
+    public:
+        using Limb = std::uint32_t;
+
+        // 两边都不少于这么多 limb 时乘法改用 Karatsuba
+        static constexpr std::size_t KaratsubaThreshold = 32;
+
+        BigInt() = default;
+
+        static BigInt FromInt(std::int64_t v);
+        static BigInt FromLimbs(std::span<const Limb> limbs, bool negative);
+
+        // 解析不带符号的数字串 (base 为 2 / 10 / 16)，含非法字符返回 nullopt
+        static std::optional<BigInt> Parse(std::string_view digits, int base);
+
+        bool IsZero() const
+        {
+            return mag.empty();
+        }
+        bool IsNegative() const
+        {
+            return negative;
+        }
+        std::span<const Limb> Limbs() const
+        {
+            return mag;
+        }
+
+        // 落在 int64 内时写入 out
+        bool ToInt64(std::int64_t &out) const;
+
+        // 正确舍入到最近的 double，超出范围得到 ±inf
+        double ToDouble() const;
+
+        String ToString() const;
+
+        BigInt operator-() const;
+
+        friend BigInt operator+(const BigInt &a, const BigInt &b);
+        friend BigInt operator-(const BigInt &a, const BigInt &b);
+        friend BigInt operator*(const BigInt &a, const BigInt &b);
+
+        // 截断除法 (同 C++ 的 / 与 %)：商向零取整，余数与被除数同号。要求 b 非零
+        static void DivMod(const BigInt &a, const BigInt &b, BigInt &quot, BigInt &rem);
+
+        friend std::strong_ordering operator<=>(const BigInt &a, const BigInt &b);
+        friend bool                 operator==(const BigInt &a, const BigInt &b) = default;
+
+    private:
+        using Mag = DynArray<Limb>;
+
+        Mag  mag;
+        bool negative = false;
+
+        BigInt(Mag m, bool neg) : mag(std::move(m)), negative(neg)
+        {
+            trim();
+        }
+
+        void trim()
+        {
+            while (!mag.empty() && mag.back() == 0)
+                mag.pop_back();
+            if (mag.empty())
+                negative = false;
+        }
+
+        static BigInt addSigned(const BigInt &a, const BigInt &b, bool negateB);
+    };
+} // namespace Fig
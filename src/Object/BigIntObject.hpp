@@ -0,0 +1,42 @@
+/*!
+    @file src/Object/BigIntObject.hpp
+    @brief 超出 48 位内联范围的整数 BigIntObject 定义
+*/
+
+#pragma once
+
+#include <Object/BigInt.hpp>
+#include <Object/ObjectBase.hpp>
+
+#include <cstdint>
+
+namespace Fig
+{
+    /*
+        不可变。VM 只为落在 Int 范围外的结果分配它 (规范形式)，
+        因此 BigInt 与 Int 的值域不相交，相等比较不必跨类型
+    */
+    struct BigIntObject final : public Object
+    {
+        // 这两个成员落在 Object 尾部的填充里，limb 紧跟在 24 字节的头部之后
+        bool          negative;
+        std::uint32_t size; // limb 个数，无前导零
+
+        BigInt::Limb limbs[];
+
+        BigInt ToBigInt() const
+        {
+            return BigInt::FromLimbs({limbs, size}, negative);
+        }
+    };
+
+    inline bool IsBigInt(Value v)
+    {
+        return v.IsObject() && v.AsObject()->type == ObjectType::BigInt;
+    }
+
+    inline const BigIntObject *AsBigInt(Value v)
+    {
+        return static_cast<const BigIntObject *>(v.AsObject());
+    }
+} // namespace Fig
@@ -17,6 +17,14 @@ namespace Fig
         Value    closedValue;       // 栈帧销毁时，数据物理迁移至此
         Upvalue *next;              // 侵入式链表，供 VM 追踪当前 Open 的 Upvalue
         std::uint32_t refCount = 0; // 多少个闭包正在使用
+        bool          remembered = false; // 已关闭且持有新生代引用，在 VM 的记忆集中
+    };
+
+    // 捕获槽位：按引用捕获持有共享的 Upvalue，按值捕获 (UpvalueInfo::byValue) 直接存值
+    union UpvalueSlot
+    {
+        Upvalue *ref;
+        Value    value;
     };
 
     struct FunctionObject final : public Object
@@ -27,7 +35,7 @@ namespace Fig
         std::uint32_t upvalueCount; // 捕获数量
 
         // 柔性数组
-        Upvalue *upvalues[];
+        UpvalueSlot upvalues[];
 
         FunctionObject(const String &_name, Proto *_proto, std::uint32_t _upvalueCount) :
             name(_name), proto(_proto), paraCount(_proto->numParams), upvalueCount(_upvalueCount)
@@ -36,5 +44,10 @@ namespace Fig
         }
 
         ~FunctionObject() = default;
+
+        bool CapturedByValue(std::uint32_t i) const
+        {
+            return proto->upvalues[i].byValue;
+        }
     };
 } // namespace Fig
\ No newline at end of file
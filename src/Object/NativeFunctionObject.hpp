@@ -0,0 +1,32 @@
+/*!
+    @file src/Object/NativeFunctionObject.hpp
+    @brief 原生函数对象定义：C++ 函数在 Fig 中的可调用表示
+*/
+
+#pragma once
+
+#include <Error/Error.hpp>
+#include <Object/ObjectBase.hpp>
+
+namespace Fig
+{
+    class VM;
+
+    /*
+        原生调用 ABI
+            args 直接指向调用者寄存器窗口 [baseReg, baseReg + argc)，不拷贝、不装箱；
+            返回值由 VM 写回 args[0]，与 Fig 函数 Return 的落点一致。
+            错误不带源码位置，由 VM 补上当前指令的位置
+    */
+    using NativeFn = Result<Value, Error> (*)(VM &vm, Value *args, std::uint8_t argc);
+
+    /*
+        原生函数对象由标准库静态持有，不经过 allocateObject，不进入 GC 链表
+    */
+    struct NativeFunctionObject final : public Object
+    {
+        const char  *name;  // 成员名, 仅供打印/报错
+        NativeFn     fn;
+        std::int16_t arity; // -1 表示可变参数
+    };
+} // namespace Fig
@@ -44,6 +44,10 @@ namespace Fig
                     auto *fnObj = static_cast<FunctionObject *>(obj);
                     return std::format("<Function: {}>", fnObj->name);
                 }
+                case ObjectType::NativeFunction: {
+                    auto *nativeObj = static_cast<NativeFunctionObject *>(obj);
+                    return std::format("<NativeFunction: {}>", nativeObj->name);
+                }
                 case ObjectType::Struct: {
                     auto *structObj = static_cast<StructObject *>(obj);
                     return std::format("<Struct: {}>", structObj->name);
@@ -56,6 +60,9 @@ namespace Fig
                     }
                     return "<Instance: Unknown>";
                 }
+                case ObjectType::BigInt: {
+                    return static_cast<BigIntObject *>(obj)->ToBigInt().ToString();
+                }
                 default: return "<Corrupted Object>";
             }
         }
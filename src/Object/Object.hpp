@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <Object/BigIntObject.hpp>
 #include <Object/FunctionObject.hpp>
 #include <Object/InstanceObject.hpp>
+#include <Object/NativeFunctionObject.hpp>
 #include <Object/ObjectBase.hpp>
 #include <Object/StringObject.hpp>
 #include <Object/StructObject.hpp>
@@ -17,6 +17,11 @@ namespace Fig
 
     struct Object; // 前置声明
 
+    namespace Jit
+    {
+        class BaselineJit; // 模板直接操作 NaN-boxing 位模式
+    }
+
     /*
         正常来说直接 Value = std::uint64_t会更快
         但是这样会带来隐式转换的问题
@@ -27,14 +32,23 @@ namespace Fig
     class Value
     {
     private:
+        friend class Jit::BaselineJit;
+
         std::uint64_t v_; // 唯一的物理成员 sizeof(Value) 永远是 8 字节。
 
         // --- 私有掩码常量 ---
         static constexpr std::uint64_t QNAN_MASK = 0x7ffc000000000000;
         static constexpr std::uint64_t SIGN_BIT  = 0x8000000000000000;
 
-        // 专门给 Int32 预留的高位 Tag
-        static constexpr std::uint32_t INT_TAG_HIGH = 0x7FFD0000;
+        /*
+            Int 占据高 16 位为 0x7FFD 的整个区间，低 48 位是有符号整数 (补码)。
+            FromDouble 把所有高位落在 QNAN_MASK 区间的 NaN 清洗成 QNAN_MASK，double 不会撞上这个 tag
+        */
+        static constexpr std::uint16_t INT_TAG_HIGH     = 0x7FFD;
+        static constexpr int           INT_PAYLOAD_BITS = 48;
+        static constexpr std::uint64_t INT_TAG          = static_cast<std::uint64_t>(INT_TAG_HIGH) << INT_PAYLOAD_BITS;
+        static constexpr std::uint64_t INT_PAYLOAD_MASK = (std::uint64_t{1} << INT_PAYLOAD_BITS) - 1;
+        static constexpr int           INT_SHIFT        = 64 - INT_PAYLOAD_BITS;
 
         // 基础原语 Tag
         static constexpr std::uint64_t TAG_NULL  = 1;
@@ -45,6 +59,46 @@ namespace Fig
         constexpr explicit Value(uint64_t raw) : v_(raw) {}
 
     public:
+        // Int 的取值范围
+        static constexpr std::int64_t IntMin = -(std::int64_t{1} << (INT_PAYLOAD_BITS - 1));
+        static constexpr std::int64_t IntMax = (std::int64_t{1} << (INT_PAYLOAD_BITS - 1)) - 1;
+
+        [[nodiscard]] static constexpr bool FitsInt(std::int64_t i)
+        {
+            return i >= IntMin && i <= IntMax;
+        }
+
+        /*
+            带溢出检查的 Int 运算，结果超出 48 位时返回 false。
+            操作数左移 16 位放到 int64 的高位再算，64 位溢出恰好等价于 48 位溢出 (JIT 里同样是一条 jo)
+        */
+        [[nodiscard]] static constexpr bool CheckedAdd(std::int64_t a, std::int64_t b, std::int64_t &out)
+        {
+            std::int64_t r;
+            if (__builtin_add_overflow(a << INT_SHIFT, b << INT_SHIFT, &r))
+                return false;
+            out = r >> INT_SHIFT;
+            return true;
+        }
+
+        [[nodiscard]] static constexpr bool CheckedSub(std::int64_t a, std::int64_t b, std::int64_t &out)
+        {
+            std::int64_t r;
+            if (__builtin_sub_overflow(a << INT_SHIFT, b << INT_SHIFT, &r))
+                return false;
+            out = r >> INT_SHIFT;
+            return true;
+        }
+
+        [[nodiscard]] static constexpr bool CheckedMul(std::int64_t a, std::int64_t b, std::int64_t &out)
+        {
+            std::int64_t r;
+            if (__builtin_mul_overflow(a << INT_SHIFT, b, &r))
+                return false;
+            out = r >> INT_SHIFT;
+            return true;
+        }
+
         // 默认构造为 Null，保证未初始化变量也是安全的
         constexpr Value()
         {
@@ -60,10 +114,11 @@ namespace Fig
             return Value(raw);
         }
 
-        [[nodiscard]] static constexpr Value FromInt(std::int32_t i)
+        // 要求 FitsInt(i)；超出范围的值由调用方先判断 (运算见 CheckedAdd 等)
+        [[nodiscard]] static constexpr Value FromInt(std::int64_t i)
         {
-            // 移位构造，彻底阻断符号扩展漏洞
-            return Value((static_cast<uint64_t>(INT_TAG_HIGH) << 32) | static_cast<uint32_t>(i));
+            // 截掉高 16 位的符号扩展再拼 tag
+            return Value(INT_TAG | (static_cast<uint64_t>(i) & INT_PAYLOAD_MASK));
         }
 
         [[nodiscard]] static constexpr Value &GetTrueInstance()
@@ -102,8 +157,7 @@ namespace Fig
 
         [[nodiscard]] constexpr bool IsInt() const
         {
-            // 安全的高 32 位移位判定
-            return static_cast<uint32_t>(v_ >> 32) == INT_TAG_HIGH;
+            return (v_ >> INT_PAYLOAD_BITS) == INT_TAG_HIGH;
         }
 
         [[nodiscard]] constexpr bool IsNumber() const
@@ -132,9 +186,10 @@ namespace Fig
             return std::bit_cast<double>(v_);
         }
 
-        [[nodiscard]] constexpr int32_t AsInt() const
+        [[nodiscard]] constexpr std::int64_t AsInt() const
         {
-            return static_cast<int32_t>(v_);
+            // 左移去掉 tag，算术右移做符号扩展
+            return static_cast<std::int64_t>(v_ << INT_SHIFT) >> INT_SHIFT;
         }
 
         // 核心辅助：泛型数字提取。算术指令可以直接用这个，免去手写 if 分支
@@ -194,8 +249,10 @@ namespace Fig
     {
         String,
         Function,
+        NativeFunction,
         Struct,
         Instance,
+        BigInt,
     };
 
     struct StructObject /* : public Object */; // 结构体基类的定义，前向声明
@@ -210,11 +267,12 @@ namespace Fig
     // Total 24 bytes size
     struct Object
     {
-        Object       *next;                   // 8 bytes: gc链表
+        Object       *next;                   // 8 bytes: 新生代 Minor GC 的转发指针
         StructObject *klass;                  // 8 bytes: 一切皆对象，父类指针
         ObjectType    type;                   // 1 byte : 类型
         GCColor       color = GCColor::White; // 1 byte : gc标记
-        // + 6 bytes padding
+        bool          remembered = false;     // 1 byte : 已在分代记忆集中
+        // + 5 bytes padding
 
         constexpr bool isString() const
         {
@@ -226,6 +284,11 @@ namespace Fig
             return type == ObjectType::Function;
         }
 
+        constexpr bool isNativeFunction() const
+        {
+            return type == ObjectType::NativeFunction;
+        }
+
         constexpr bool isStruct() const
         {
             return type == ObjectType::Struct;
@@ -235,6 +298,11 @@ namespace Fig
         {
             return type == ObjectType::Instance;
         }
+
+        constexpr bool isBigInt() const
+        {
+            return type == ObjectType::BigInt;
+        }
     };
 } // namespace Fig
 
@@ -9,6 +9,8 @@
 
 #include <Object/ObjectBase.hpp>
 
+#include <cstdint>
+
 namespace Fig
 {
     /*
@@ -24,6 +26,25 @@ namespace Fig
     */
     struct StringObject final : public Object
     {
+        // 这两个成员落在 Object 尾部的填充里 (Itanium ABI 复用非 POD 基类的尾部填充)，对象仍是 64 bytes
+        bool          interned; // 在 VM 的驻留表中：内容相同的驻留字符串只有这一个
+        std::uint32_t hash;     // 创建时算好的内容哈希 (StringHash)
+
         String data; // 40 bytes
     };
+
+    inline std::uint32_t StringHash(const String &data)
+    {
+        return static_cast<std::uint32_t>(std::hash<String>{}(data));
+    }
+
+    // 内容相等。两边都已驻留时地址不同即不等，哈希不同也不必比较内容
+    inline bool StringEquals(const StringObject *a, const StringObject *b)
+    {
+        if (a == b)
+            return true;
+        if ((a->interned && b->interned) || a->hash != b->hash)
+            return false;
+        return a->data == b->data;
+    }
 };
\ No newline at end of file
@@ -28,8 +28,9 @@ namespace Fig
         String name; // 元信息(仅供调试/打印/反射)
 
         // 内存布局信息
-        std::uint8_t fieldCount;
-        Object      *operators[GetOperatorsSize()];
+        std::uint8_t     fieldCount;
+        DynArray<String> fieldNames; // 按槽位排列，与 Analyzer 中 StructType::fields 的顺序一致
+        Object          *operators[GetOperatorsSize()];
         /*
             运算符重载，nullptr代表无重载
             一般为 NativeFunction / Function
@@ -40,6 +41,17 @@ namespace Fig
         */
 
 
+        // 按名字查字段槽位，没有返回 -1 (只在字段访问的内联缓存未命中时调用)
+        int FieldIndex(const String &field) const
+        {
+            for (std::size_t i = 0; i < fieldNames.size(); ++i)
+            {
+                if (fieldNames[i] == field)
+                    return static_cast<int>(i);
+            }
+            return -1;
+        }
+
         Object *GetUnaryOperator(UnaryOperator _op)
         {
             std::uint8_t idx = static_cast<std::uint8_t>(_op);
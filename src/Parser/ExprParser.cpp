@@ -5,6 +5,7 @@
     @date 2026-02-14
 */
 
+#include <Ast/Expr/ObjectInitExpr.hpp>
 #include <Parser/Parser.hpp>
 
 namespace Fig
@@ -35,6 +36,19 @@ namespace Fig
         BinaryOperator op       = TokenToBinaryOp(op_token);
         BindingPower   rbp      = GetBinaryOpRBp(op);
 
+        // obj.member: 右侧只取一个标识符，否则 a.f(x) 会被后缀调用吸走成 a.(f(x))
+        if (op == BinaryOperator::MemberAccess)
+        {
+            const Token &name = currentToken();
+            if (!name.isIdentifier())
+            {
+                return std::unexpected(makeUnexpectTokenError("member access", "member name", name));
+            }
+            consumeToken();
+            return arena.Allocate<MemberExpr>(
+                lhs, srcManager.GetSub(name.index, name.length), makeSourceLocation(name));
+        }
+
         const auto &rhs_result = parseExpression(rbp);
         if (!rhs_result)
         {
@@ -143,6 +157,68 @@ namespace Fig
         return arena.Allocate<CallExpr>(callee, callArgs);
     }
 
+    /*
+        new Point{x: 1, y: 2}   具名
+        new Point{1, 2}         按字段顺序
+        new Point{y, x}         简写：同名变量，顺序任意
+        后两种在这里都只是无名参数，由 Analyzer 按字段表区分并解析出槽位
+    */
+    Result<Expr *, Error> Parser::parseNewExpr() // 当前token为 `new`
+    {
+        StateProtector p(this, {State::ParsingNewExpr});
+
+        SourceLocation location = makeSourceLocation(consumeToken()); // consume `new`
+
+        auto typeResult = parseTypeExpr();
+        if (!typeResult)
+        {
+            return std::unexpected(typeResult.error());
+        }
+
+        if (currentToken().type != TokenType::LeftBrace)
+        {
+            return std::unexpected(makeUnexpectTokenError("new expr", "LeftBrace `{`", currentToken()));
+        }
+        const Token &lbrace_token = consumeToken(); // consume `{`
+
+        DynArray<ObjectInitExpr::Arg> args;
+        while (!match(TokenType::RightBrace))
+        {
+            if (currentToken().type == TokenType::EndOfFile)
+            {
+                return std::unexpected(Error(ErrorType::SyntaxError,
+                    "new expr has unclosed braces",
+                    "insert `}`",
+                    makeSourceLocation(lbrace_token)));
+            }
+
+            String name;
+            if (currentToken().isIdentifier() && peekToken().type == TokenType::Colon)
+            {
+                const Token &nameToken = consumeToken();
+                name                   = srcManager.GetSub(nameToken.index, nameToken.length);
+                consumeToken(); // consume `:`
+            }
+
+            const auto &value_result = parseExpression();
+            if (!value_result)
+            {
+                return std::unexpected(value_result.error());
+            }
+            args.push_back({std::move(name), *value_result});
+
+            if (!match(TokenType::Comma) && currentToken().type != TokenType::RightBrace)
+            {
+                return std::unexpected(Error(ErrorType::SyntaxError,
+                    "expected `,` or `}` in new expr",
+                    "insert `,`",
+                    makeSourceLocation(currentToken())));
+            }
+        }
+
+        return arena.Allocate<ObjectInitExpr>(*typeResult, std::move(args), location);
+    }
+
     Result<Expr *, Error> Parser::parseExpression(BindingPower rbp)
     {
         Expr *lhs   = nullptr;
@@ -175,6 +251,15 @@ namespace Fig
             }
             lhs = *lhs_result;
         }
+        else if (token.type == TokenType::New)
+        {
+            const auto &lhs_result = parseNewExpr();
+            if (!lhs_result)
+            {
+                return std::unexpected(lhs_result.error());
+            }
+            lhs = *lhs_result;
+        }
         else if (token.type == TokenType::LeftParen)
         {
             const Token &lparen_token = consumeToken(); // consume `(`
@@ -122,6 +122,7 @@ namespace Fig
                 ParsingPrefixExpr,
                 ParsingIndexExpr,
                 ParsingCallExpr,
+                ParsingNewExpr,
                 ParsingVarDecl,
                 ParsingIf,
                 ParsingWhile,
@@ -129,6 +130,8 @@ namespace Fig
                 ParsingReturn,
                 ParsingBreak,
                 ParsingContinue,
+                ParsingImport,
+                ParsingStructDef,
                 ParsingNamedTypeExpr,
             } type                               = StateType::Standby;
             std::unordered_set<TokenType> stopAt = {};
@@ -245,6 +248,7 @@ namespace Fig
         Result<DynArray<Param *>, Error> parseFnParams();
         Result<FnDefStmt *, Error>       parseFnDefStmt(bool);
         Result<ReturnStmt *, Error>      parseReturnStmt();
+        Result<ImportStmt *, Error>      parseImportStmt();
 
         Result<Stmt *, Error> parseStructDef(bool);
         Result<Stmt *, Error> parseInterfaceDef(bool);
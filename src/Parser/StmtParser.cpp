@@ -5,6 +5,7 @@
     @date 2026-02-19
 */
 
+#include <Ast/Stmt/StructDefStmt.hpp>
 #include <Parser/Parser.hpp>
 
 namespace Fig
@@ -429,6 +430,121 @@ namespace Fig
         return returnStmt;
     }
 
+    Result<ImportStmt *, Error> Parser::parseImportStmt()
+    {
+        StateProtector p(this, {State::ParsingImport});
+
+        SourceLocation   location = makeSourceLocation(consumeToken()); // consume `import`
+        DynArray<String> path;
+
+        while (true)
+        {
+            const Token &name = currentToken();
+            if (!name.isIdentifier())
+            {
+                return std::unexpected(makeUnexpectTokenError("import", "module name", name));
+            }
+            path.push_back(srcManager.GetSub(name.index, name.length));
+            consumeToken();
+
+            if (!match(TokenType::Dot))
+                break;
+        }
+
+        if (!match(TokenType::Semicolon))
+        {
+            return std::unexpected(makeExpectSemicolonError());
+        }
+        return arena.Allocate<ImportStmt>(std::move(path), location);
+    }
+
+    /*
+        struct Point
+        {
+            x: Int;        // 字段之间用 `;` 或 `,` 分隔，类型可省略 (Any)
+            public y;
+            public func f() {}
+        }
+    */
+    Result<Stmt *, Error> Parser::parseStructDef(bool isPublic)
+    {
+        StateProtector p(this, {State::ParsingStructDef});
+
+        SourceLocation location = makeSourceLocation(consumeToken()); // consume `struct`
+
+        if (!currentToken().isIdentifier())
+        {
+            return std::unexpected(makeUnexpectTokenError("struct def", "struct name", currentToken()));
+        }
+        const Token  &nameToken = consumeToken();
+        const String &name      = srcManager.GetSub(nameToken.index, nameToken.length);
+
+        if (!match(TokenType::LeftBrace))
+        {
+            return std::unexpected(makeUnexpectTokenError("struct def", "LeftBrace `{`", currentToken()));
+        }
+
+        DynArray<StructDefStmt::Field> fields;
+        while (!match(TokenType::RightBrace))
+        {
+            if (currentToken().type == TokenType::EndOfFile)
+            {
+                return std::unexpected(Error(ErrorType::SyntaxError,
+                    "unclosed braces in struct def",
+                    "insert '}'",
+                    location));
+            }
+
+            bool memberPublic = match(TokenType::Public);
+            if (currentToken().type == TokenType::Function)
+            {
+                // Analyzer 与编译器还不处理方法，解析后丢弃会让方法体里的错误被静默接受
+                return std::unexpected(Error(ErrorType::SyntaxError,
+                    "struct methods are not supported yet",
+                    "define a free function taking the struct as its first parameter",
+                    makeSourceLocation(currentToken())));
+            }
+
+            if (!currentToken().isIdentifier())
+            {
+                return std::unexpected(makeUnexpectTokenError("struct def", "field name", currentToken()));
+            }
+            const Token &fieldToken = consumeToken();
+            String       fieldName  = srcManager.GetSub(fieldToken.index, fieldToken.length);
+            for (const auto &f : fields)
+            {
+                if (f.name == fieldName)
+                {
+                    return std::unexpected(Error(ErrorType::RedeclarationError,
+                        "field redeclared",
+                        "rename the field",
+                        makeSourceLocation(fieldToken)));
+                }
+            }
+
+            TypeExpr *fieldType = nullptr;
+            if (match(TokenType::Colon))
+            {
+                auto result = parseTypeExpr();
+                if (!result)
+                {
+                    return std::unexpected(result.error());
+                }
+                fieldType = *result;
+            }
+            fields.push_back({std::move(fieldName), fieldType, memberPublic});
+
+            if (!match(TokenType::Semicolon) && !match(TokenType::Comma)
+                && currentToken().type != TokenType::RightBrace)
+            {
+                return std::unexpected(makeUnexpectTokenError("struct def", "`;` or `,`", currentToken()));
+            }
+        }
+
+        return arena.Allocate<StructDefStmt>(
+            isPublic, name, DynArray<String>{}, std::move(fields), DynArray<FnDefStmt *>{}, location);
+    }
+
     Result<Stmt *, Error> Parser::parseStatement()
     {
         StateProtector p(this, {State::Standby});
@@ -446,6 +562,11 @@ namespace Fig
                 return parseFnDefStmt(true);
             }
 
+            if (currentToken().type == TokenType::Struct)
+            {
+                return parseStructDef(true);
+            }
+
             return std::unexpected(
                 makeUnexpectTokenError("public", "var/const/func/struct", currentToken()));
         }
@@ -480,6 +601,16 @@ namespace Fig
             return parseReturnStmt();
         }
 
+        if (currentToken().type == TokenType::Struct)
+        {
+            return parseStructDef(false);
+        }
+
+        if (currentToken().type == TokenType::Import)
+        {
+            return parseImportStmt();
+        }
+
         if (match(TokenType::Break))
         {
             SourceLocation location = makeSourceLocation(prevToken());
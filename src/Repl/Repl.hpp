@@ -254,7 +254,7 @@ namespace Fig
                 }
             }
 
-            return (v.IsInt() ? v.AsInt() : 0);
+            return (v.IsInt() ? static_cast<int>(v.AsInt()) : 0);
         }
     };
 }; // namespace Fig
\ No newline at end of file
@@ -10,13 +10,15 @@
 #include <Ast/Stmt/InterfaceDefStmt.hpp>
 #include <Ast/Stmt/StructDefStmt.hpp>
 #include <Sema/Analyzer.hpp>
+#include <Std/StdLib.hpp>
 
 namespace Fig
 {
     struct AnalyzerState
     {
-        int        loopDepth = 0;
-        FnDefStmt *currentFn = nullptr;
+        int        loopDepth  = 0;
+        int        fnLoopBase = 0; // 进入当前函数时的 loopDepth
+        FnDefStmt *currentFn  = nullptr;
     } state;
 
     struct ScopeGuard
@@ -49,13 +51,16 @@ namespace Fig
     {
         FnDefStmt *&current;
         FnDefStmt  *old;
-        FnStateGuard(FnDefStmt *&c, FnDefStmt *n) : current(c), old(c)
+        int         oldLoopBase;
+        FnStateGuard(FnDefStmt *&c, FnDefStmt *n) : current(c), old(c), oldLoopBase(state.fnLoopBase)
         {
-            current = n;
+            current          = n;
+            state.fnLoopBase = state.loopDepth;
         }
         ~FnStateGuard()
         {
-            current = old;
+            current          = old;
+            state.fnLoopBase = oldLoopBase;
         }
     };
 
@@ -84,10 +89,20 @@ namespace Fig
                 if (globalTypes.contains(s->name))
                     return std::unexpected(
                         Error(ErrorType::RedeclarationError, "type redeclared", "", s->location));
-                auto *t = arena.Allocate<StructType>(s->name);
+                auto *t = new StructType(s->name); // 归 TypeContext 所有，由它析构释放
                 typeCtx.allTypes.push_back(t);
                 globalTypes[s->name] = t;
             }
+            else if (stmt->type == AstType::ImportStmt)
+            {
+                auto *i = static_cast<ImportStmt *>(stmt);
+                if (i->path.size() != 2 || i->path[0] != "std" || !Std::IsModule(i->path[1]))
+                    return std::unexpected(Error(ErrorType::UseUndeclaredIdentifier,
+                        "unknown module",
+                        "available modules: std.io, std.time, std.value",
+                        i->location));
+                importedModules[i->path[1]] = i->path[1];
+            }
             else if (stmt->type == AstType::FnDefStmt)
             {
                 auto *f = static_cast<FnDefStmt *>(stmt);
@@ -201,9 +216,11 @@ namespace Fig
                 SymbolLocation loc =
                     env.current->parent ? SymbolLocation::Local : SymbolLocation::Global;
                 int idx = (loc == SymbolLocation::Local) ? env.current->nextLocalId++ : 0;
-                env.current->locals[v->name] =
-                    arena.Allocate<Symbol>(v->name, declT, loc, idx, false);
-                v->localId = idx;
+                Symbol *sym = arena.Allocate<Symbol>(v->name, declT, loc, idx, false);
+                // 循环体内的声明每轮都会重新写入槽位
+                sym->capturableByValue       = state.loopDepth == state.fnLoopBase;
+                env.current->locals[v->name] = sym;
+                v->localId                   = idx;
                 break;
             }
 
@@ -243,18 +260,23 @@ namespace Fig
                 ScopeGuard   scopeGuard(env, true);
                 for (auto *p : f->params)
                 {
-                    env.current->locals[p->name] = arena.Allocate<Symbol>(p->name,
+                    Symbol *sym = arena.Allocate<Symbol>(p->name,
                         p->resolvedType,
                         SymbolLocation::Local,
                         env.current->nextLocalId++,
                         false);
+                    sym->capturableByValue       = true;
+                    env.current->locals[p->name] = sym;
                 }
                 if (auto r = analyzeStmt(f->body); !r)
                     return r;
 
                 for (const auto &upval : env.current->upvalues)
                 {
-                    f->upvalues.push_back({static_cast<std::uint8_t>(upval.index), upval.isLocal});
+                    // 局部变量取其寄存器号，继承的 upvalue 取它在外层闭包里的下标
+                    f->upvalues.push_back({static_cast<std::uint8_t>(upval.target->index), upval.isLocal});
+                    f->captureTargets.push_back(
+                        upval.target->origin ? upval.target->origin : upval.target);
                 }
 
                 break;
@@ -356,6 +378,12 @@ namespace Fig
                 }
                 break;
             }
+            case AstType::ImportStmt:
+                // 顶层 import 已在 pass1 登记
+                if (env.current->parent)
+                    return std::unexpected(Error(
+                        ErrorType::SyntaxError, "import must be at top level", "", stmt->location));
+                break;
             case AstType::ExprStmt: {
                 auto res = analyzeExpr(static_cast<ExprStmt *>(stmt)->expr);
                 if (!res)
@@ -392,8 +420,28 @@ namespace Fig
                 return expr->resolvedType = (*res)->type;
             }
             case AstType::MemberExpr: {
-                auto *m         = static_cast<MemberExpr *>(expr);
-                auto  targetRes = analyzeExpr(m->target);
+                auto *m = static_cast<MemberExpr *>(expr);
+
+                // 模块成员：同名变量优先，未被遮蔽时解析为原生函数编号
+                if (m->target->type == AstType::IdentiExpr)
+                {
+                    auto *id = static_cast<IdentiExpr *>(m->target);
+                    if (importedModules.contains(id->name)
+                        && !resolveSymbolInternal(id->name, id->location, env.current))
+                    {
+                        const String &module = importedModules[id->name];
+                        auto          native = Std::FindNative(module, m->name);
+                        if (!native)
+                            return std::unexpected(Error(ErrorType::UseUndeclaredIdentifier,
+                                "module '" + module + "' has no member named '" + m->name + "'",
+                                "",
+                                m->location));
+                        m->nativeId = static_cast<int>(*native);
+                        return expr->resolvedType = typeCtx.GetBasic(TypeTag::Any);
+                    }
+                }
+
+                auto targetRes = analyzeExpr(m->target);
                 if (!targetRes)
                     return targetRes;
 
@@ -424,17 +472,60 @@ namespace Fig
                     return std::unexpected(
                         Error(ErrorType::TypeError, "requires struct", "", o->location));
                 auto *st = static_cast<StructType *>(res->base);
+
+                // 无名参数全是同名字段的标识符时为简写 (顺序任意)，否则按字段顺序
+                bool hasNamed = false, hasUnnamed = false, shorthand = true;
                 for (auto &arg : o->args)
                 {
-                    if (!arg.name.empty() && !st->fieldMap.contains(arg.name))
-                        return std::unexpected(
-                            Error(ErrorType::TypeError, "unknown field", "", arg.value->location));
+                    if (!arg.name.empty())
+                    {
+                        hasNamed = true;
+                        continue;
+                    }
+                    hasUnnamed = true;
+                    if (arg.value->type != AstType::IdentiExpr
+                        || !st->fieldMap.contains(static_cast<IdentiExpr *>(arg.value)->name))
+                        shorthand = false;
+                }
+                bool positional = hasUnnamed && !shorthand;
+                if (positional && hasNamed)
+                    return std::unexpected(Error(ErrorType::TypeError,
+                        "cannot mix positional and named field initializers",
+                        "",
+                        o->location));
+                if (positional && o->args.size() > st->fields.size())
+                    return std::unexpected(
+                        Error(ErrorType::TypeError, "too many field initializers", "", o->location));
+
+                DynArray<bool> seen(st->fields.size(), false);
+                for (size_t i = 0; i < o->args.size(); ++i)
+                {
+                    auto  &arg = o->args[i];
+                    size_t idx = i;
+                    if (!arg.name.empty())
+                    {
+                        if (!st->fieldMap.contains(arg.name))
+                            return std::unexpected(
+                                Error(ErrorType::TypeError, "unknown field", "", arg.value->location));
+                        idx = st->fieldMap[arg.name];
+                    }
+                    else if (!positional)
+                    {
+                        idx = st->fieldMap[static_cast<IdentiExpr *>(arg.value)->name];
+                    }
+                    if (seen[idx])
+                        return std::unexpected(Error(ErrorType::TypeError,
+                            "field '" + st->fields[idx].name + "' initialized more than once",
+                            "",
+                            arg.value->location));
+                    seen[idx]      = true;
+                    arg.fieldIndex = static_cast<int>(idx);
+
                     auto r = analyzeExpr(arg.value);
                     if (!r)
                         return std::unexpected(r.error());
                     // 字段赋值类型检查
-                    if (!arg.name.empty()
-                        && !r->isAssignableTo(st->fields[st->fieldMap[arg.name]].type))
+                    if (!r->isAssignableTo(st->fields[idx].type))
                     {
                         return std::unexpected(Error(
                             ErrorType::TypeError, "field type mismatch", "", arg.value->location));
@@ -455,6 +546,11 @@ namespace Fig
 
                 if (in->op == BinaryOperator::Assign)
                 {
+                    if (in->left->type == AstType::IdentiExpr)
+                    {
+                        Symbol *sym = static_cast<IdentiExpr *>(in->left)->resolvedSymbol;
+                        (sym->origin ? sym->origin : sym)->capturableByValue = false;
+                    }
                     if (!r.isAssignableTo(l))
                         return std::unexpected(Error(ErrorType::TypeError,
                             "cannot assign '" + r.toString() + "' to '" + l.toString() + "'",
@@ -502,6 +598,24 @@ namespace Fig
                     argTypes.push_back(*ar);
                 }
 
+                // 原生函数只有参数个数
+                if (c->callee->type == AstType::MemberExpr)
+                {
+                    int nativeId = static_cast<MemberExpr *>(c->callee)->nativeId;
+                    if (nativeId >= 0)
+                    {
+                        const auto &info = Std::GetNativeInfo(static_cast<Std::NativeId>(nativeId));
+                        if (info.arity >= 0 && static_cast<std::size_t>(info.arity) != argTypes.size())
+                        {
+                            return std::unexpected(Error(ErrorType::TypeError,
+                                "expected " + std::to_string(info.arity) + " arguments, got "
+                                    + std::to_string(argTypes.size()),
+                                "",
+                                c->location));
+                        }
+                    }
+                }
+
                 if (calleeType.is(TypeTag::Any))
                     return expr->resolvedType = typeCtx.GetBasic(TypeTag::Any);
 
@@ -559,8 +673,10 @@ namespace Fig
             if (outer->location == SymbolLocation::Global)
                 return outer;
             int idx = addUpvalue(curr, outer, outer->location == SymbolLocation::Local);
-            return arena.Allocate<Symbol>(
+            Symbol *sym = arena.Allocate<Symbol>(
                 name, outer->type, SymbolLocation::Upvalue, idx, outer->isConst);
+            sym->origin = outer->origin ? outer->origin : outer;
+            return sym;
         }
         if (globalSymbols.contains(name))
             return globalSymbols[name];
@@ -570,9 +686,14 @@ namespace Fig
 
     int Analyzer::addUpvalue(Scope *s, Symbol *t, bool isL)
     {
+        // 经外层函数解析出的 upvalue 符号每次都是新分配的，按源头变量去重
+        Symbol *origin = t->origin ? t->origin : t;
         for (size_t i = 0; i < s->upvalues.size(); ++i)
-            if (s->upvalues[i].target == t)
+        {
+            Symbol *u = s->upvalues[i].target;
+            if ((u->origin ? u->origin : u) == origin)
                 return (int) i;
+        }
         int idx = (int) s->upvalues.size();
         s->upvalues.push_back({t, idx, isL});
         return idx;
@@ -26,6 +26,9 @@ namespace Fig
         HashMap<String, BaseType*> globalTypes;
         HashMap<String, Symbol*>   globalSymbols;
 
+        // import std.io => importedModules["io"] = "io"
+        HashMap<String, String> importedModules;
+
         bool hasInit = false;
         bool hasMain = false;
 
@@ -25,6 +25,13 @@ namespace Fig
         int            index;
         bool           isConst;
 
+        /*
+            可按值捕获：参数或不在循环体内声明的局部变量，且之后从未被赋值。
+            闭包创建时拷贝一份即可，不需要 Upvalue 跟踪栈槽位
+        */
+        bool    capturableByValue = false;
+        Symbol *origin            = nullptr; // Upvalue 符号指向被捕获的原始局部变量
+
         Symbol(String n, Type t, SymbolLocation l, int i, bool c) :
             name(std::move(n)), type(t), location(l), index(i), isConst(c)
         {
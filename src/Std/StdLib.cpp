@@ -0,0 +1,139 @@
+/*!
+    @file src/Std/StdLib.cpp
+    @brief 标准库原生函数实现：std.io / std.time / std.value
+*/
+
+#include <Std/StdLib.hpp>
+#include <VM/VM.hpp>
+
+#include <charconv>
+#include <chrono>
+#include <string>
+
+namespace Fig::Std
+{
+    static Error argumentError(const char *fn, const char *expected, Value got)
+    {
+        return Error(ErrorType::TypeError,
+            std::format("{} expects {}, got `{}`", fn, expected, got.ToString()),
+            "none",
+            {});
+    }
+
+    static bool isString(Value v)
+    {
+        return v.IsObject() && v.AsObject()->isString();
+    }
+
+    static const String &asString(Value v)
+    {
+        return static_cast<StringObject *>(v.AsObject())->data;
+    }
+
+    // --- std.io ---
+
+    static Result<Value, Error> ioPrint(VM &, Value *args, std::uint8_t argc)
+    {
+        std::ostream &out = CoreIO::GetStdOut();
+        for (std::uint8_t i = 0; i < argc; ++i)
+        {
+            out << args[i].ToString();
+        }
+        return Value::GetNullInstance();
+    }
+
+    static Result<Value, Error> ioPrintln(VM &vm, Value *args, std::uint8_t argc)
+    {
+        ioPrint(vm, args, argc);
+        CoreIO::GetStdOut() << '\n';
+        return Value::GetNullInstance();
+    }
+
+    // 读取一行 (不含换行符)，EOF 时返回 null
+    static Result<Value, Error> ioRead(VM &vm, Value *, std::uint8_t)
+    {
+        std::string line;
+        if (!std::getline(CoreIO::GetStdCin(), line))
+            return Value::GetNullInstance();
+        return vm.NewString(String(line));
+    }
+
+    // --- std.time ---
+
+    // 单调时钟秒数 (Double)，只用于计算时间差
+    static Result<Value, Error> timeNow(VM &, Value *, std::uint8_t)
+    {
+        auto since = Time::Clock::now().time_since_epoch();
+        return Value::FromDouble(std::chrono::duration<double>(since).count());
+    }
+
+    // --- std.value ---
+
+    // 解析失败或超出 Int 范围返回 null
+    static Result<Value, Error> valueIntParse(VM &, Value *args, std::uint8_t)
+    {
+        if (!isString(args[0]))
+            return std::unexpected(argumentError("value.int_parse", "String", args[0]));
+
+        std::string  s = asString(args[0]).toStdString();
+        std::int64_t v;
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+        if (ec != std::errc() || ptr != s.data() + s.size() || !Value::FitsInt(v))
+            return Value::GetNullInstance();
+        return Value::FromInt(v);
+    }
+
+    static Result<Value, Error> valueDoubleParse(VM &, Value *args, std::uint8_t)
+    {
+        if (!isString(args[0]))
+            return std::unexpected(argumentError("value.double_parse", "String", args[0]));
+
+        std::string s = asString(args[0]).toStdString();
+        double      v;
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+        if (ec != std::errc() || ptr != s.data() + s.size())
+            return Value::GetNullInstance();
+        return Value::FromDouble(v);
+    }
+
+    static Result<Value, Error> valueStringFrom(VM &vm, Value *args, std::uint8_t)
+    {
+        if (isString(args[0]))
+            return args[0];
+        return vm.NewString(args[0].ToString());
+    }
+
+    // 原生函数对象是静态的，不在 GC 堆里，恒为 Black
+    static NativeFunctionObject makeNative(NativeId id, NativeFn fn)
+    {
+        NativeFunctionObject native;
+        native.next  = nullptr;
+        native.color = GCColor::Black;
+        native.klass = nullptr;
+        native.type  = ObjectType::NativeFunction;
+        native.name  = GetNativeInfo(id).name;
+        native.fn    = fn;
+        native.arity = GetNativeInfo(id).arity;
+        return native;
+    }
+
+    // 与 NativeId 顺序一致
+    static NativeFunctionObject nativeObjects[] = {
+        makeNative(NativeId::IoPrint, ioPrint),
+        makeNative(NativeId::IoPrintln, ioPrintln),
+        makeNative(NativeId::IoRead, ioRead),
+
+        makeNative(NativeId::TimeNow, timeNow),
+
+        makeNative(NativeId::ValueIntParse, valueIntParse),
+        makeNative(NativeId::ValueDoubleParse, valueDoubleParse),
+        makeNative(NativeId::ValueStringFrom, valueStringFrom),
+    };
+
+    static_assert(std::size(nativeObjects) == static_cast<std::size_t>(NativeId::Count));
+
+    NativeFunctionObject *GetNativeObject(std::uint16_t id)
+    {
+        return &nativeObjects[id];
+    }
+} // namespace Fig::Std
@@ -0,0 +1,85 @@
+/*!
+    @file src/Std/StdLib.hpp
+    @brief 标准库模块注册表：import std.xxx 的名字解析与原生函数编号
+*/
+
+#pragma once
+
+#include <Deps/Deps.hpp>
+#include <Object/NativeFunctionObject.hpp>
+
+#include <cstdint>
+#include <optional>
+
+namespace Fig::Std
+{
+    /*
+        原生函数编号，编译期写进 CallNative / LoadNative 的操作数。
+        顺序即 StdLib.cpp 中原生函数对象表的顺序
+    */
+    enum class NativeId : std::uint8_t
+    {
+        IoPrint,
+        IoPrintln,
+        IoRead,
+
+        TimeNow,
+
+        ValueIntParse,
+        ValueDoubleParse,
+        ValueStringFrom,
+
+        Count
+    };
+
+    struct NativeInfo
+    {
+        const char  *module;
+        const char  *name;
+        std::int16_t arity; // -1 表示可变参数
+    };
+
+    // 只有名字与参数个数，Analyzer / Compiler 不需要链接原生实现
+    inline constexpr NativeInfo NativeInfos[] = {
+        {"io", "print", -1},
+        {"io", "println", -1},
+        {"io", "read", 0},
+
+        {"time", "now", 0},
+
+        {"value", "int_parse", 1},
+        {"value", "double_parse", 1},
+        {"value", "string_from", 1},
+    };
+
+    static_assert(std::size(NativeInfos) == static_cast<std::size_t>(NativeId::Count));
+
+    // import std.<module>
+    inline bool IsModule(const String &module)
+    {
+        for (const NativeInfo &info : NativeInfos)
+        {
+            if (module == String(info.module))
+                return true;
+        }
+        return false;
+    }
+
+    inline std::optional<NativeId> FindNative(const String &module, const String &name)
+    {
+        for (std::size_t i = 0; i < std::size(NativeInfos); ++i)
+        {
+            if (module == String(NativeInfos[i].module) && name == String(NativeInfos[i].name))
+                return static_cast<NativeId>(i);
+        }
+        return std::nullopt;
+    }
+
+    inline const NativeInfo &GetNativeInfo(NativeId id)
+    {
+        return NativeInfos[static_cast<std::size_t>(id)];
+    }
+
+    // 静态原生函数对象 (StdLib.cpp)，VM 执行 CallNative / LoadNative 时取用
+    NativeFunctionObject *GetNativeObject(std::uint16_t id);
+} // namespace Fig::Std
@@ -21,7 +21,7 @@
 
 namespace Fig::Entry
 {
-    void RunFromPath(const String &path)
+    void RunFromPath(const String &path, const VMConfig &config)
     {
         namespace fs = std::filesystem;
 
@@ -86,9 +86,17 @@ namespace Fig::Entry
 
         CompiledModule *compiledModule = *compile_result;
 
-        VM vm;
+        VM vm(config);
 
         auto execute_result = vm.Execute(compiledModule);
+        if (config.quickenStats)
+        {
+            vm.PrintQuickenStats();
+        }
+        if (config.gcTrace)
+        {
+            vm.PrintGCSummary();
+        }
         if (!execute_result)
         {
             ReportError(execute_result.error(), manager);
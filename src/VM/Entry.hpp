@@ -6,8 +6,9 @@
 */
 
 #include <Deps/Deps.hpp>
+#include <VM/VMConfig.hpp>
 
 namespace Fig::Entry
 {
-    void RunFromPath(const String &);
+    void RunFromPath(const String &, const VMConfig & = {});
 };
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*!
+    @file src/VM/GCStats.hpp
+    @brief GC 统计：停顿直方图、分配 / 回收 / 晋升计数与按类型的存活量
+*/
+
+#pragma once
+
+#include <Core/RuntimeTime.hpp>
+#include <Object/ObjectBase.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace Fig
+{
+    /*
+        按 2 的幂微秒分桶：桶 0 为 < 1us，桶 i 为 [2^(i-1), 2^i) us，
+        最后一个桶收下所有更长的停顿 (>= 2^(BucketCount-2) us，约 0.26s)
+    */
+    struct PauseHistogram
+    {
+        static constexpr std::size_t BucketCount = 20;
+
+        std::array<std::uint64_t, BucketCount> buckets{};
+        std::uint64_t                          count      = 0;
+        std::uint64_t                          totalNanos = 0;
+        std::uint64_t                          maxNanos   = 0;
+
+        static std::size_t BucketOf(std::uint64_t nanos)
+        {
+            std::uint64_t micros = nanos / 1000;
+            std::size_t   b      = static_cast<std::size_t>(std::bit_width(micros));
+            return b < BucketCount ? b : BucketCount - 1;
+        }
+
+        // 桶的上界 (微秒)，最后一个桶没有上界，返回其下界
+        static std::uint64_t BucketLimitMicros(std::size_t b)
+        {
+            return b + 1 < BucketCount ? std::uint64_t{1} << b : std::uint64_t{1} << (b - 1);
+        }
+
+        void Record(std::uint64_t nanos)
+        {
+            buckets[BucketOf(nanos)]++;
+            count++;
+            totalNanos += nanos;
+            if (nanos > maxNanos)
+                maxNanos = nanos;
+        }
+
+        // 第 p 分位停顿所在桶的上界 (微秒)，p 取 (0, 1]
+        std::uint64_t PercentileMicros(double p) const
+        {
+            if (count == 0)
+                return 0;
+            auto          rank = static_cast<std::uint64_t>(p * static_cast<double>(count) + 0.5);
+            std::uint64_t seen = 0;
+            for (std::size_t b = 0; b < BucketCount; ++b)
+            {
+                seen += buckets[b];
+                if (seen >= rank && seen > 0)
+                    return BucketLimitMicros(b);
+            }
+            return BucketLimitMicros(BucketCount - 1);
+        }
+    };
+
+    // 停顿按发生的位置分类；Minor GC 也会发生在标记末步中，此时两边都计入
+    enum class GCPause : std::uint8_t
+    {
+        MarkStart, // 扫描根、开始一轮
+        Mark,      // 增量标记步
+        Sweep,     // 增量清扫步
+        Minor,     // 新生代回收
+        Parallel,  // --gc-threads > 1 时的整轮并行标记
+        Full,      // 触及堆上限时的完整同步回收
+
+        Count
+    };
+
+    inline constexpr std::size_t ObjectTypeCount = static_cast<std::size_t>(ObjectType::BigInt) + 1;
+
+    struct GCStats
+    {
+        std::uint64_t cycles           = 0; // 已开始的老年代回收轮数
+        std::uint64_t minorCollections = 0;
+
+        std::array<PauseHistogram, static_cast<std::size_t>(GCPause::Count)> pauses{};
+
+        std::uint64_t bytesAllocated   = 0; // 对象请求的字节 (不含格子取整)
+        std::uint64_t objectsAllocated = 0;
+        std::uint64_t bytesFreed       = 0; // 老年代清扫回收的格子 + 新生代中死去的对象
+        std::uint64_t bytesPromoted    = 0;
+        std::uint64_t objectsPromoted  = 0;
+        std::uint64_t objectsEvacuated = 0; // Immix 疏散搬动的对象
+
+        // 最近一次统计时的存活对象 (老年代已清扫完时准确，否则包含待清扫的垃圾)
+        std::array<std::uint64_t, ObjectTypeCount> liveBytes{};
+        std::array<std::uint64_t, ObjectTypeCount> liveObjects{};
+
+        Time::Clock::time_point startTime = Time::Clock::now();
+
+        PauseHistogram &Pause(GCPause kind)
+        {
+            return pauses[static_cast<std::size_t>(kind)];
+        }
+        const PauseHistogram &Pause(GCPause kind) const
+        {
+            return pauses[static_cast<std::size_t>(kind)];
+        }
+    };
+} // namespace Fig
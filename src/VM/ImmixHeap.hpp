@@ -0,0 +1,648 @@
+/*!
+    @file src/VM/ImmixHeap.hpp
+    @brief 老年代 Immix 式标记-区域分配器：块 / 行两级区域，空闲行内指针碰撞分配，碎片块择机疏散
+*/
+
+#pragma once
+
+#include <Object/ObjectBase.hpp>
+#include <VM/PageHeap.hpp> // PageMemory
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace Fig
+{
+    /*
+        块 32KB，按 256B 分行 (本 VM 的字符串、闭包多在 64~128B，行太小时空洞放不下几个对象)，块头占块首几行：
+            startBits  每 16B 粒度一位，置位处是一个已分配对象的起点 (清扫、遍历只看它)
+            markBits   本轮的标记位，代替对象头的 color
+            lineMarks  清扫时被存活对象覆盖的行；连续的空闲行就是之后碰撞分配的空洞
+        新分配的对象在内存里按分配顺序相邻，不再按大小级别分散到不同的页。
+
+        本堆对象的 color 恒为 White，标记只看 markBits；新生代与常驻对象 (常量池字符串、
+        原生函数) 仍用 color，常驻对象恒为 Black。
+        大于 MediumLimit 的对象单独映射，头部与块头有相同的 kind 前缀，标记位在头里
+    */
+    class ImmixHeap
+    {
+    public:
+        static constexpr std::size_t BlockSize   = 32 * 1024;
+        static constexpr std::size_t LineSize    = 256;
+        static constexpr std::size_t Granule     = 16;
+        static constexpr std::size_t MediumLimit = BlockSize / 4;
+
+        // SweepStep 每清扫一个单位折合的回收工作量 (字节)
+        static constexpr std::size_t SweepUnit = BlockSize;
+
+        // 回收对象前释放其 C++ 资源 (不释放内存本身)
+        using Finalizer = void (*)(Object *);
+        // 对象实际占用字节，清扫时据此标记覆盖的行
+        using SizeOf = std::size_t (*)(const Object *);
+
+    private:
+        static constexpr std::size_t LineCount    = BlockSize / LineSize;
+        static constexpr std::size_t LineWords    = LineCount / 64;
+        static constexpr std::size_t GranuleCount = BlockSize / Granule;
+        static constexpr std::size_t GranuleWords = GranuleCount / 64;
+
+        // 没有空洞可用时最多就地清扫的块数
+        static constexpr int SweepBlocksPerAllocation = 2;
+
+        // 存活字节低于可用容量的这个百分比的块作为疏散候选
+        static constexpr std::size_t EvacuateOccupancyPercent = 25;
+
+        // 疏散后修正引用要走一遍全部存活对象，候选块能腾出的空间不到已用字节的 1/N 时不值得
+        static constexpr std::size_t EvacuateMinGainDivisor = 16;
+
+        enum class Kind : std::uint8_t
+        {
+            Block,
+            Large
+        };
+
+        struct Block
+        {
+            Kind          kind;
+            bool          sparse;     // 上次清扫时存活字节占比低，下一轮的疏散候选
+            bool          evacuating; // 本轮确定要疏散
+            std::uint32_t freeLines;
+            Block        *next;           // 块链表
+            Block        *nextRecyclable; // 有空洞的块链表
+            std::uint64_t lineMarks[LineWords];
+            std::uint64_t startBits[GranuleWords];
+            std::uint64_t markBits[GranuleWords];
+
+            std::byte *base()
+            {
+                return reinterpret_cast<std::byte *>(this);
+            }
+
+            Object *objectAt(std::size_t granule)
+            {
+                return reinterpret_cast<Object *>(base() + granule * Granule);
+            }
+
+            std::size_t granuleOf(const void *p) const
+            {
+                return static_cast<std::size_t>(
+                           static_cast<const std::byte *>(p) - reinterpret_cast<const std::byte *>(this))
+                    / Granule;
+            }
+        };
+
+        struct Large
+        {
+            Kind         kind;
+            std::uint8_t marked;
+            Large       *next;
+            std::size_t  mappedBytes;
+            std::size_t  size;
+
+            Object *object()
+            {
+                return reinterpret_cast<Object *>(reinterpret_cast<std::byte *>(this) + LargeOffset);
+            }
+        };
+
+        static constexpr std::size_t FirstLine   = (sizeof(Block) + LineSize - 1) / LineSize;
+        static constexpr std::size_t LargeOffset = (sizeof(Large) + Granule - 1) & ~(Granule - 1);
+        static constexpr std::size_t BlockBytes  = (LineCount - FirstLine) * LineSize; // 块的可用容量
+
+        // PageMemory 按 PageHeap::PageSize 对齐，块与大对象映射的首地址都是 BlockSize 的倍数
+        static_assert(PageHeap::PageSize % BlockSize == 0);
+        static_assert(LargeOffset < BlockSize);
+
+        static bool testBit(const std::uint64_t *bits, std::size_t i)
+        {
+            return (bits[i / 64] >> (i % 64)) & 1;
+        }
+        static void setBit(std::uint64_t *bits, std::size_t i)
+        {
+            bits[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+        static void clearBit(std::uint64_t *bits, std::size_t i)
+        {
+            bits[i / 64] &= ~(std::uint64_t{1} << (i % 64));
+        }
+
+        // 对象所在映射的首地址：小对象是块头，大对象 (位于映射首个 BlockSize 内) 是其头部
+        static void *headerOf(const Object *obj)
+        {
+            return reinterpret_cast<void *>(reinterpret_cast<std::uintptr_t>(obj) & ~(std::uintptr_t{BlockSize} - 1));
+        }
+
+        static Kind kindOf(const Object *obj)
+        {
+            return *static_cast<const Kind *>(headerOf(obj));
+        }
+
+        // 依次访问块中起点位置位的对象
+        template <typename F>
+        static void forEachStart(Block *block, F &&visit)
+        {
+            for (std::size_t w = 0; w < GranuleWords; ++w)
+            {
+                for (std::uint64_t bits = block->startBits[w]; bits; bits &= bits - 1)
+                    visit(w * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+            }
+        }
+
+        Finalizer finalize;
+        SizeOf    sizeOf;
+
+        Block *blocks     = nullptr; // 已清扫或本轮新建的块
+        Block *unswept    = nullptr;
+        Block *recyclable = nullptr; // blocks 中还有空洞、尚未被分配器取走的块
+        Large *larges     = nullptr;
+        Large *unsweptLarges = nullptr;
+
+        // 当前空洞 [cursor, limit)；currentLine 是当前块里下一次找洞的起始行
+        Block      *current     = nullptr;
+        std::size_t currentLine = LineCount;
+        std::byte  *cursor      = nullptr;
+        std::byte  *limit       = nullptr;
+
+        // 放不进当前空洞的中等对象 (大于一行) 改从溢出块碰撞分配，避免为它跳过小空洞
+        std::byte *overflowCursor = nullptr;
+        std::byte *overflowLimit  = nullptr;
+
+        std::size_t mappedBytes = 0;
+        std::size_t usedBytes   = 0; // 已分配对象的总字节 (含尚未清扫的垃圾)
+        std::size_t freedBytes  = 0; // 累计清扫回收的字节
+        std::size_t sparseGain  = 0; // 上一轮清扫出的稀疏块全部疏散能腾出的字节
+
+        static std::size_t alignSize(std::size_t size)
+        {
+            return (size + Granule - 1) & ~(Granule - 1);
+        }
+
+        // 块头所在的行始终视为占用
+        static void resetLineMarks(Block *block)
+        {
+            std::fill(std::begin(block->lineMarks), std::end(block->lineMarks), 0);
+            for (std::size_t l = 0; l < FirstLine; ++l)
+                setBit(block->lineMarks, l);
+        }
+
+        Block *freshBlock()
+        {
+            auto *block = static_cast<Block *>(PageMemory::Map(BlockSize));
+            if (!block)
+                return nullptr;
+            mappedBytes += BlockSize;
+
+            block->kind           = Kind::Block;
+            block->sparse         = false;
+            block->evacuating     = false;
+            block->freeLines      = static_cast<std::uint32_t>(LineCount - FirstLine);
+            block->nextRecyclable = nullptr;
+            resetLineMarks(block);
+            std::fill(std::begin(block->startBits), std::end(block->startBits), 0);
+            std::fill(std::begin(block->markBits), std::end(block->markBits), 0);
+
+            block->next = blocks;
+            blocks      = block;
+            return block;
+        }
+
+        void releaseBlock(Block *block)
+        {
+            mappedBytes -= BlockSize;
+            PageMemory::Unmap(block, BlockSize);
+        }
+
+        // 从 line 起找下一个空洞，找到则设为当前空洞
+        bool nextHole(Block *block, std::size_t &line)
+        {
+            while (line < LineCount && testBit(block->lineMarks, line))
+                ++line;
+            if (line >= LineCount)
+                return false;
+
+            std::size_t end = line;
+            while (end < LineCount && !testBit(block->lineMarks, end))
+                ++end;
+
+            cursor = block->base() + line * LineSize;
+            limit  = block->base() + end * LineSize;
+            line   = end;
+            return true;
+        }
+
+        void *bump(std::byte *&from, std::size_t size)
+        {
+            auto *obj = reinterpret_cast<Object *>(from);
+            from += size;
+
+            auto *block = static_cast<Block *>(headerOf(obj));
+            setBit(block->startBits, block->granuleOf(obj));
+            usedBytes += size;
+            return obj;
+        }
+
+        /*
+            清扫一块：未标记的对象析构后清掉起点位，存活对象覆盖的行记入 lineMarks，
+            标记位整体清零以备下一轮 (不需要逐个对象洗白)。返回块是否已空
+        */
+        bool sweepBlock(Block *block)
+        {
+            resetLineMarks(block);
+            std::size_t live = 0;
+
+            forEachStart(block, [&](std::size_t g) {
+                Object     *obj  = block->objectAt(g);
+                std::size_t size = alignSize(sizeOf(obj));
+                if (testBit(block->markBits, g))
+                {
+                    std::size_t offset = g * Granule;
+                    for (std::size_t l = offset / LineSize; l <= (offset + size - 1) / LineSize; ++l)
+                        setBit(block->lineMarks, l);
+                    live += size;
+                }
+                else
+                {
+                    finalize(obj);
+                    clearBit(block->startBits, g);
+                    usedBytes -= size;
+                    freedBytes += size;
+                }
+            });
+            std::fill(std::begin(block->markBits), std::end(block->markBits), 0);
+
+            std::size_t marked = 0;
+            for (std::uint64_t w : block->lineMarks)
+                marked += static_cast<std::size_t>(std::popcount(w));
+            block->freeLines = static_cast<std::uint32_t>(LineCount - marked);
+            block->sparse    = live * 100 < BlockBytes * EvacuateOccupancyPercent;
+            if (live > 0 && block->sparse)
+                sparseGain += BlockBytes - live;
+            return live == 0;
+        }
+
+        // 清扫 unswept 头部的一块：空块归还系统，有空洞的进入 recyclable
+        void sweepNextBlock()
+        {
+            Block *block = unswept;
+            unswept      = block->next;
+            if (sweepBlock(block))
+            {
+                releaseBlock(block);
+                return;
+            }
+
+            block->next = blocks;
+            blocks      = block;
+            if (block->freeLines > 0)
+            {
+                block->nextRecyclable = recyclable;
+                recyclable            = block;
+            }
+        }
+
+        void sweepNextLarge()
+        {
+            Large *large  = unsweptLarges;
+            unsweptLarges = large->next;
+            if (large->marked)
+            {
+                large->marked = 0;
+                large->next   = larges;
+                larges        = large;
+                return;
+            }
+
+            finalize(large->object());
+            usedBytes -= large->size;
+            freedBytes += large->size;
+            mappedBytes -= large->mappedBytes;
+            PageMemory::Unmap(large, large->mappedBytes);
+        }
+
+        // 先用清扫出的空洞，清扫期间就地清扫少量块，都没有才向系统要新块
+        Block *acquireBlock()
+        {
+            for (int i = 0; !recyclable && unswept && i < SweepBlocksPerAllocation; ++i)
+                sweepNextBlock();
+
+            if (Block *block = recyclable)
+            {
+                recyclable = block->nextRecyclable;
+                return block;
+            }
+            return freshBlock();
+        }
+
+        void *allocateLarge(std::size_t size)
+        {
+            std::size_t bytes = (LargeOffset + size + PageHeap::PageSize - 1) & ~(PageHeap::PageSize - 1);
+            auto       *large = static_cast<Large *>(PageMemory::Map(bytes));
+            if (!large)
+                return nullptr;
+            mappedBytes += bytes;
+
+            large->kind        = Kind::Large;
+            large->marked      = 0;
+            large->mappedBytes = bytes;
+            large->size        = size;
+            large->next        = larges;
+            larges             = large;
+
+            usedBytes += size;
+            return large->object();
+        }
+
+        void *allocateOverflow(std::size_t size)
+        {
+            if (static_cast<std::size_t>(overflowLimit - overflowCursor) < size)
+            {
+                Block *block = freshBlock();
+                if (!block)
+                    return nullptr;
+                overflowCursor = block->base() + FirstLine * LineSize;
+                overflowLimit  = block->base() + BlockSize;
+            }
+            return bump(overflowCursor, size);
+        }
+
+        void *allocateSlow(std::size_t size)
+        {
+            if (size > LineSize)
+                return allocateOverflow(size);
+
+            // 一个空洞至少一行，放得下任何小对象
+            while (!current || !nextHole(current, currentLine))
+            {
+                current = acquireBlock();
+                if (!current)
+                    return nullptr;
+                currentLine = FirstLine;
+            }
+            return bump(cursor, size);
+        }
+
+        static void releaseBlocks(Block *block, std::size_t &mapped)
+        {
+            while (block)
+            {
+                Block *next = block->next;
+                mapped -= BlockSize;
+                PageMemory::Unmap(block, BlockSize);
+                block = next;
+            }
+        }
+
+        static void releaseLarges(Large *large, std::size_t &mapped)
+        {
+            while (large)
+            {
+                Large *next = large->next;
+                mapped -= large->mappedBytes;
+                PageMemory::Unmap(large, large->mappedBytes);
+                large = next;
+            }
+        }
+
+    public:
+        ImmixHeap(Finalizer _finalize, SizeOf _sizeOf) : finalize(_finalize), sizeOf(_sizeOf) {}
+
+        ImmixHeap(const ImmixHeap &)            = delete;
+        ImmixHeap &operator=(const ImmixHeap &) = delete;
+
+        ~ImmixHeap()
+        {
+            releaseBlocks(blocks, mappedBytes);
+            releaseBlocks(unswept, mappedBytes);
+            releaseLarges(larges, mappedBytes);
+            releaseLarges(unsweptLarges, mappedBytes);
+        }
+
+        // 系统内存耗尽返回 nullptr
+        [[nodiscard]] void *Allocate(std::size_t size)
+        {
+            size = alignSize(size);
+            if (size > MediumLimit) [[unlikely]]
+                return allocateLarge(size);
+
+            if (static_cast<std::size_t>(limit - cursor) >= size) [[likely]]
+                return bump(cursor, size);
+            return allocateSlow(size);
+        }
+
+        // 未标记则标记并返回 true
+        static bool TryMark(Object *obj)
+        {
+            if (kindOf(obj) == Kind::Large)
+            {
+                auto *large = static_cast<Large *>(headerOf(obj));
+                if (large->marked)
+                    return false;
+                large->marked = 1;
+                return true;
+            }
+            auto       *block = static_cast<Block *>(headerOf(obj));
+            std::size_t g     = block->granuleOf(obj);
+            if (testBit(block->markBits, g))
+                return false;
+            setBit(block->markBits, g);
+            return true;
+        }
+
+        // 并行标记用：同一个字里的位可能被多个线程同时设置
+        static bool TryMarkAtomic(Object *obj)
+        {
+            if (kindOf(obj) == Kind::Large)
+            {
+                auto *large = static_cast<Large *>(headerOf(obj));
+                return std::atomic_ref<std::uint8_t>(large->marked).exchange(1, std::memory_order_relaxed) == 0;
+            }
+            auto         *block = static_cast<Block *>(headerOf(obj));
+            std::size_t   g     = block->granuleOf(obj);
+            std::uint64_t bit   = std::uint64_t{1} << (g % 64);
+            std::uint64_t old =
+                std::atomic_ref<std::uint64_t>(block->markBits[g / 64]).fetch_or(bit, std::memory_order_relaxed);
+            return !(old & bit);
+        }
+
+        static bool IsMarked(const Object *obj)
+        {
+            if (kindOf(obj) == Kind::Large)
+                return static_cast<const Large *>(headerOf(obj))->marked;
+            auto *block = static_cast<const Block *>(headerOf(obj));
+            return testBit(block->markBits, block->granuleOf(obj));
+        }
+
+        static void SetMarked(Object *obj)
+        {
+            TryMark(obj);
+        }
+
+        /*
+            疏散：标记完成、清扫开始前调用。存活字节占比低的块里的已标记对象搬进新块，
+            旧位置清掉起点位并在 next 中留下新地址，由调用方修正所有引用。
+            与 Immix 原文一样由上一轮清扫的统计挑候选 (稀疏块)，之后被分配填满的不再疏散；
+            碎片不多时直接跳过。每轮搬动量不超过已用字节的 1/8 (至少 8 块)，返回搬动的对象数
+        */
+        std::size_t EvacuateFragmented()
+        {
+            if (sparseGain * EvacuateMinGainDivisor < usedBytes)
+                return 0;
+
+            std::size_t budget = std::max(usedBytes / 8, 8 * BlockBytes);
+            std::size_t gain   = 0; // 候选块疏散后腾出的字节
+            std::size_t moved  = 0;
+
+            for (Block *block = blocks; block; block = block->next)
+            {
+                if (!block->sparse)
+                    continue;
+                std::size_t live = 0;
+                forEachStart(block, [&](std::size_t g) {
+                    if (testBit(block->markBits, g))
+                        live += alignSize(sizeOf(block->objectAt(g)));
+                });
+                if (live > 0 && live * 100 < BlockBytes * EvacuateOccupancyPercent && live <= budget)
+                {
+                    block->evacuating = true;
+                    budget -= live;
+                    gain += BlockBytes - live;
+                }
+            }
+
+            if (gain * EvacuateMinGainDivisor < usedBytes)
+            {
+                for (Block *block = blocks; block; block = block->next)
+                    block->evacuating = false;
+                return 0;
+            }
+
+            // 目标块都是新块，插在链表头，不会被下面的遍历再访问到
+            std::byte *to      = nullptr;
+            std::byte *toLimit = nullptr;
+            bool       full    = false;
+            for (Block *block = blocks; block; block = block->next)
+            {
+                if (!block->evacuating)
+                    continue;
+                block->evacuating = false;
+                if (full)
+                    continue;
+
+                forEachStart(block, [&](std::size_t g) {
+                    if (full || !testBit(block->markBits, g))
+                        return;
+                    Object     *obj  = block->objectAt(g);
+                    std::size_t size = alignSize(sizeOf(obj));
+                    if (static_cast<std::size_t>(toLimit - to) < size)
+                    {
+                        Block *target = freshBlock();
+                        if (!target)
+                        {
+                            full = true; // 映射失败就停止疏散，剩下的对象留在原处
+                            return;
+                        }
+                        to      = target->base() + FirstLine * LineSize;
+                        toLimit = target->base() + BlockSize;
+                    }
+
+                    auto *copy = static_cast<Object *>(bump(to, size));
+                    std::memcpy(static_cast<void *>(copy), obj, size);
+                    copy->next = nullptr;
+                    SetMarked(copy);
+
+                    clearBit(block->startBits, g);
+                    clearBit(block->markBits, g);
+                    usedBytes -= size;
+                    obj->next = copy;
+                    moved++;
+                });
+            }
+            return moved;
+        }
+
+        // 标记结束：全部块转为待清扫 (上一轮必须已清扫完)，分配器丢掉当前空洞
+        void BeginSweep()
+        {
+            sparseGain    = 0;
+            unswept       = blocks;
+            blocks        = nullptr;
+            recyclable    = nullptr;
+            unsweptLarges = larges;
+            larges        = nullptr;
+
+            current        = nullptr;
+            currentLine    = LineCount;
+            cursor         = nullptr;
+            limit          = nullptr;
+            overflowCursor = nullptr;
+            overflowLimit  = nullptr;
+        }
+
+        // 最多清扫 budget 块 (大对象一个算一块)，全部清扫完返回 true
+        bool SweepStep(std::size_t budget)
+        {
+            for (; budget > 0 && (unswept || unsweptLarges); --budget)
+            {
+                if (unswept)
+                    sweepNextBlock();
+                else
+                    sweepNextLarge();
+            }
+            return !unswept && !unsweptLarges;
+        }
+
+        // 遍历所有已分配对象，包括尚未清扫的垃圾
+        template <typename F>
+        void ForEachObject(F &&visit)
+        {
+            for (Block *list : {blocks, unswept})
+            {
+                for (Block *block = list; block; block = block->next)
+                    forEachStart(block, [&](std::size_t g) { visit(block->objectAt(g)); });
+            }
+            for (Large *list : {larges, unsweptLarges})
+            {
+                for (Large *large = list; large; large = large->next)
+                    visit(large->object());
+            }
+        }
+
+        // 遍历本轮已标记的对象 (疏散后修正引用用，此时还没有开始清扫)
+        template <typename F>
+        void ForEachMarkedObject(F &&visit)
+        {
+            for (Block *block = blocks; block; block = block->next)
+            {
+                forEachStart(block, [&](std::size_t g) {
+                    if (testBit(block->markBits, g))
+                        visit(block->objectAt(g));
+                });
+            }
+            for (Large *large = larges; large; large = large->next)
+            {
+                if (large->marked)
+                    visit(large->object());
+            }
+        }
+
+        std::size_t UsedBytes() const
+        {
+            return usedBytes;
+        }
+
+        std::size_t MappedBytes() const
+        {
+            return mappedBytes;
+        }
+
+        std::size_t FreedBytes() const
+        {
+            return freedBytes;
+        }
+    };
+} // namespace Fig
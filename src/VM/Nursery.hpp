@@ -0,0 +1,90 @@
+/*!
+    @file src/VM/Nursery.hpp
+    @brief 新生代：连续内存上的指针碰撞分配区
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+namespace Fig
+{
+    /*
+        新对象先在这里按 8 字节对齐顺序分配，分配只是一次指针加法。
+        Minor GC 把存活对象晋升到老年代后整体 Reset，死对象不逐个 free
+    */
+    class Nursery
+    {
+    private:
+        std::byte *base = nullptr;
+        std::byte *top  = nullptr;
+        std::byte *end  = nullptr;
+
+    public:
+        static constexpr std::size_t Alignment = 8;
+
+        static constexpr std::size_t AlignSize(std::size_t size)
+        {
+            return (size + Alignment - 1) & ~(Alignment - 1);
+        }
+
+        explicit Nursery(std::size_t bytes)
+        {
+            bytes = AlignSize(bytes);
+            base  = static_cast<std::byte *>(std::malloc(bytes));
+            top   = base;
+            end   = base ? base + bytes : nullptr;
+        }
+
+        ~Nursery()
+        {
+            std::free(base);
+        }
+
+        Nursery(const Nursery &)            = delete;
+        Nursery &operator=(const Nursery &) = delete;
+
+        // 空间不足返回 nullptr，由调用方先做 Minor GC
+        [[nodiscard]] inline void *Allocate(std::size_t size)
+        {
+            size = AlignSize(size);
+            if (static_cast<std::size_t>(end - top) < size) [[unlikely]]
+                return nullptr;
+            void *p = top;
+            top += size;
+            return p;
+        }
+
+        [[nodiscard]] inline bool Contains(const void *p) const
+        {
+            return p >= base && p < top;
+        }
+
+        std::size_t Capacity() const
+        {
+            return static_cast<std::size_t>(end - base);
+        }
+
+        std::size_t Used() const
+        {
+            return static_cast<std::size_t>(top - base);
+        }
+
+        // 已分配区间 [Begin, Top)，Minor GC 据此线性遍历
+        std::byte *Begin() const
+        {
+            return base;
+        }
+
+        std::byte *Top() const
+        {
+            return top;
+        }
+
+        void Reset()
+        {
+            top = base;
+        }
+    };
+} // namespace Fig
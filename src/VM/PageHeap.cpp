@@ -0,0 +1,53 @@
+/*!
+    @file src/VM/PageHeap.cpp
+    @brief 老年代页的系统映射 (mmap / VirtualAlloc)
+*/
+
+#include <VM/PageHeap.hpp>
+
+#include <cstdint>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace Fig::PageMemory
+{
+    /*
+        Windows 的分配粒度就是 64KB，天然对齐；
+        POSIX 多映射一页再裁掉首尾，得到 PageSize 对齐的起点
+    */
+    void *Map(std::size_t bytes)
+    {
+#if defined(_WIN32)
+        return VirtualAlloc(nullptr, bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+        constexpr std::size_t align = PageHeap::PageSize;
+
+        std::size_t span = bytes + align;
+        void       *raw  = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            return nullptr;
+
+        auto begin   = reinterpret_cast<std::uintptr_t>(raw);
+        auto aligned = (begin + align - 1) & ~(std::uintptr_t{align} - 1);
+        if (std::size_t head = aligned - begin)
+            munmap(raw, head);
+        if (std::size_t tail = span - (aligned - begin) - bytes)
+            munmap(reinterpret_cast<void *>(aligned + bytes), tail);
+        return reinterpret_cast<void *>(aligned);
+#endif
+    }
+
+    void Unmap(void *p, std::size_t bytes)
+    {
+#if defined(_WIN32)
+        (void) bytes;
+        VirtualFree(p, 0, MEM_RELEASE);
+#else
+        munmap(p, bytes);
+#endif
+    }
+} // namespace Fig::PageMemory
@@ -0,0 +1,393 @@
+/*!
+    @file src/VM/PageHeap.hpp
+    @brief 老年代分页分配器：按大小分级的页，页内空闲链表 + 存活位图
+*/
+
+#pragma once
+
+#include <Object/ObjectBase.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace Fig
+{
+    /*
+        页直接向操作系统申请 (mmap / VirtualAlloc)，按 PageSize 对齐，
+        清扫后变空的页立即归还，峰值过后 RSS 会回落
+    */
+    namespace PageMemory
+    {
+        // 失败返回 nullptr
+        void *Map(std::size_t bytes);
+        void  Unmap(void *p, std::size_t bytes);
+    } // namespace PageMemory
+
+    class PageHeap
+    {
+    public:
+        static constexpr std::size_t PageSize  = 64 * 1024;
+        static constexpr std::size_t CellAlign = 16;
+
+        // SweepStep 每清扫一个单位折合的回收工作量 (字节)
+        static constexpr std::size_t SweepUnit = PageSize;
+
+        /*
+            大小级别与对象头对应 (Object 24B)：
+                48   空 Instance / 少量字段
+                64   StringObject (24 + String 40)
+                96   FunctionObject (无 upvalue ~88)
+                112.. 带 upvalue 的闭包、多字段 Instance
+            超过最大级别的对象独占一段映射 (大对象页)
+        */
+        static constexpr std::array<std::uint32_t, 14> SizeClasses = {
+            32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 512};
+        static constexpr std::size_t MaxSmallSize = SizeClasses.back();
+
+    private:
+        static constexpr std::size_t MaxCells    = PageSize / 32;
+        static constexpr std::size_t BitmapWords = MaxCells / 64;
+
+        // 最后一个级别放大对象页 (每页一个对象，不参与空闲格子分配)
+        static constexpr std::size_t  ClassCount = SizeClasses.size() + 1;
+        static constexpr std::uint8_t LargeClass = SizeClasses.size();
+
+        // 分配时最多就地清扫的页数 (一页至多 2000 余个格子)
+        static constexpr int SweepPagesPerAllocation = 2;
+
+    public:
+        // 回收对象前释放其 C++ 资源 (不释放格子本身)
+        using Finalizer = void (*)(Object *);
+
+    private:
+        struct FreeCell
+        {
+            FreeCell *next;
+        };
+
+        /*
+            页头放在页首，对象格子从 cellsOffset 开始。
+            liveBits 中置位的格子里是一个已分配对象，清扫与遍历只看位图，不再需要全局对象链表
+        */
+        struct Page
+        {
+            Page         *next;          // 同级别页链表
+            Page         *nextAvailable; // 有空闲格子的页链表
+            FreeCell     *freeList;
+            std::size_t   mappedBytes;   // 大对象页的映射长度
+            std::uint32_t cellSize;
+            std::uint32_t cellCount;
+            std::uint32_t freshIndex;    // 从未分配过的格子起点 (新页不预先串链表)
+            std::uint32_t liveCount;
+            std::uint8_t  sizeClass;
+            std::uint64_t liveBits[BitmapWords];
+
+            std::byte *cells()
+            {
+                return reinterpret_cast<std::byte *>(this) + cellsOffset();
+            }
+
+            Object *cellAt(std::size_t i)
+            {
+                return reinterpret_cast<Object *>(cells() + i * cellSize);
+            }
+
+            std::size_t indexOf(const void *p)
+            {
+                return static_cast<std::size_t>(static_cast<const std::byte *>(p) - cells()) / cellSize;
+            }
+
+            void setLive(std::size_t i)
+            {
+                liveBits[i / 64] |= (std::uint64_t{1} << (i % 64));
+            }
+
+            void clearLive(std::size_t i)
+            {
+                liveBits[i / 64] &= ~(std::uint64_t{1} << (i % 64));
+            }
+
+            bool hasFreeCell() const
+            {
+                return freeList || freshIndex < cellCount;
+            }
+        };
+
+        static constexpr std::size_t cellsOffset()
+        {
+            return (sizeof(Page) + CellAlign - 1) & ~(CellAlign - 1);
+        }
+
+        /*
+            惰性清扫：标记结束时整级别的页挪到 unswept，之后由分配与 GC 步一页一页清扫回 pages。
+            只从 pages 中分配，所以 unswept 页里的白色对象一定是本轮垃圾
+        */
+        struct SizeClassList
+        {
+            Page *pages     = nullptr; // 已清扫或本轮新建的页
+            Page *unswept   = nullptr;
+            Page *available = nullptr; // pages 中还有空闲格子的页
+        };
+
+        std::array<SizeClassList, ClassCount> classes{};
+        Finalizer                             finalize;
+
+        std::size_t sweepCursor = ClassCount; // SweepStep 正在清扫的级别
+        std::size_t mappedBytes = 0;          // 当前向系统申请的总字节
+        std::size_t usedBytes   = 0;          // 已分配格子的总字节 (含尚未清扫的垃圾)
+        std::size_t freedBytes  = 0;          // 累计清扫回收的格子字节
+
+        static constexpr std::uint8_t sizeClassOf(std::size_t size)
+        {
+            std::uint8_t c = 0;
+            while (SizeClasses[c] < size)
+                ++c;
+            return c;
+        }
+
+        Page *mapPage(std::size_t bytes, std::uint8_t sizeClass, std::uint32_t cellSize)
+        {
+            auto *page = static_cast<Page *>(PageMemory::Map(bytes));
+            if (!page)
+                return nullptr;
+            mappedBytes += bytes;
+
+            page->nextAvailable = nullptr;
+            page->freeList      = nullptr;
+            page->mappedBytes   = bytes;
+            page->cellSize      = cellSize;
+            page->cellCount     = static_cast<std::uint32_t>((bytes - cellsOffset()) / cellSize);
+            page->freshIndex    = 0;
+            page->liveCount     = 0;
+            page->sizeClass     = sizeClass;
+            std::fill(std::begin(page->liveBits), std::end(page->liveBits), 0);
+            return page;
+        }
+
+        void linkPage(SizeClassList &list, Page *page)
+        {
+            page->next = list.pages;
+            list.pages = page;
+            if (page->sizeClass != LargeClass && page->hasFreeCell())
+            {
+                page->nextAvailable = list.available;
+                list.available      = page;
+            }
+        }
+
+        void *allocateLarge(std::size_t size)
+        {
+            std::size_t bytes = (cellsOffset() + size + PageSize - 1) & ~(PageSize - 1);
+            Page       *page  = mapPage(bytes, LargeClass, static_cast<std::uint32_t>(size));
+            if (!page)
+                return nullptr;
+
+            page->cellCount  = 1;
+            page->freshIndex = 1;
+            page->liveCount  = 1;
+            page->setLive(0);
+            linkPage(classes[LargeClass], page);
+
+            usedBytes += size;
+            return page->cells();
+        }
+
+        void releasePage(Page *page)
+        {
+            mappedBytes -= page->mappedBytes;
+            PageMemory::Unmap(page, page->mappedBytes);
+        }
+
+        // 白色对象析构后回收格子，其余洗白；返回页是否已空
+        bool sweepPage(Page *page)
+        {
+            for (std::size_t w = 0; w < BitmapWords; ++w)
+            {
+                std::uint64_t bits = page->liveBits[w];
+                while (bits)
+                {
+                    std::size_t i   = w * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                    Object     *obj = page->cellAt(i);
+                    bits &= bits - 1;
+
+                    if (obj->color == GCColor::White)
+                    {
+                        finalize(obj);
+                        page->clearLive(i);
+                        auto *cell     = reinterpret_cast<FreeCell *>(obj);
+                        cell->next     = page->freeList;
+                        page->freeList = cell;
+                        page->liveCount--;
+                        usedBytes -= page->cellSize;
+                        freedBytes += page->cellSize;
+                    }
+                    else
+                    {
+                        obj->color = GCColor::White;
+                    }
+                }
+            }
+            return page->liveCount == 0;
+        }
+
+        // 清扫 unswept 链表头部的一页：空页归还系统，其余回到 pages
+        void sweepNext(SizeClassList &list)
+        {
+            Page *page   = list.unswept;
+            list.unswept = page->next;
+            if (sweepPage(page))
+                releasePage(page);
+            else
+                linkPage(list, page);
+        }
+
+        void releaseList(Page *page)
+        {
+            while (page)
+            {
+                Page *next = page->next;
+                releasePage(page);
+                page = next;
+            }
+        }
+
+    public:
+        explicit PageHeap(Finalizer _finalize) : finalize(_finalize) {}
+
+        PageHeap(const PageHeap &)            = delete;
+        PageHeap &operator=(const PageHeap &) = delete;
+
+        ~PageHeap()
+        {
+            for (SizeClassList &list : classes)
+            {
+                releaseList(list.pages);
+                releaseList(list.unswept);
+            }
+        }
+
+        // 实际占用的格子大小
+        static constexpr std::size_t CellSizeFor(std::size_t size)
+        {
+            return size <= MaxSmallSize ? SizeClasses[sizeClassOf(size)] : size;
+        }
+
+        // 系统内存耗尽返回 nullptr
+        [[nodiscard]] void *Allocate(std::size_t size)
+        {
+            if (size > MaxSmallSize) [[unlikely]]
+                return allocateLarge(size);
+
+            std::uint8_t   sizeClass = sizeClassOf(size);
+            SizeClassList &list      = classes[sizeClass];
+
+            // 清扫期间先就地清扫本级别的少量页，仍没有空闲格子才向系统要新页
+            for (int i = 0; !list.available && list.unswept && i < SweepPagesPerAllocation; ++i)
+                sweepNext(list);
+
+            Page *page = list.available;
+            if (!page) [[unlikely]]
+            {
+                page = mapPage(PageSize, sizeClass, SizeClasses[sizeClass]);
+                if (!page)
+                    return nullptr;
+                linkPage(list, page);
+            }
+
+            void *cell;
+            if (page->freeList)
+            {
+                cell           = page->freeList;
+                page->freeList = page->freeList->next;
+            }
+            else
+            {
+                cell = page->cellAt(page->freshIndex++);
+            }
+            page->setLive(page->indexOf(cell));
+            page->liveCount++;
+            usedBytes += page->cellSize;
+
+            if (!page->hasFreeCell())
+            {
+                // 页满，移出可分配链表，下次清扫后再回来
+                list.available = page->nextAvailable;
+            }
+            return cell;
+        }
+
+        // 标记结束：全部页转为待清扫 (上一轮必须已清扫完)
+        void BeginSweep()
+        {
+            for (SizeClassList &list : classes)
+            {
+                list.unswept   = list.pages;
+                list.pages     = nullptr;
+                list.available = nullptr;
+            }
+            sweepCursor = 0;
+        }
+
+        /*
+            最多清扫 pageBudget 页，全部清扫完返回 true。
+            白色对象交给 Finalizer 后回收，其余洗白以备下一轮；空页归还系统
+        */
+        bool SweepStep(std::size_t pageBudget)
+        {
+            while (sweepCursor < ClassCount && pageBudget > 0)
+            {
+                SizeClassList &list = classes[sweepCursor];
+                if (!list.unswept)
+                {
+                    ++sweepCursor;
+                    continue;
+                }
+                sweepNext(list);
+                --pageBudget;
+            }
+            while (sweepCursor < ClassCount && !classes[sweepCursor].unswept)
+                ++sweepCursor;
+            return sweepCursor == ClassCount;
+        }
+
+        // 遍历所有已分配对象，包括尚未清扫的垃圾 (VM 析构时释放 C++ 资源)
+        template <typename F>
+        void ForEachObject(F &&visit)
+        {
+            auto walk = [&](Page *page) {
+                for (; page; page = page->next)
+                {
+                    for (std::size_t w = 0; w < BitmapWords; ++w)
+                    {
+                        for (std::uint64_t bits = page->liveBits[w]; bits; bits &= bits - 1)
+                            visit(page->cellAt(w * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+                    }
+                }
+            };
+            for (SizeClassList &list : classes)
+            {
+                walk(list.pages);
+                walk(list.unswept);
+            }
+        }
+
+        std::size_t UsedBytes() const
+        {
+            return usedBytes;
+        }
+
+        std::size_t MappedBytes() const
+        {
+            return mappedBytes;
+        }
+
+        std::size_t FreedBytes() const
+        {
+            return freedBytes;
+        }
+    };
+} // namespace Fig
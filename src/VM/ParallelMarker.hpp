@@ -0,0 +1,270 @@
+/*!
+    @file src/VM/ParallelMarker.hpp
+    @brief 并行标记：多线程排空灰色对象，线程间工作窃取
+*/
+
+#pragma once
+
+#include <Object/ObjectBase.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Fig
+{
+    // 默认着色：对象头 color。White -> Gray 用原子 CAS 抢占，扫描完写 Black
+    struct ColorMarks
+    {
+        static bool TryMark(Object *obj)
+        {
+            GCColor expected = GCColor::White;
+            return std::atomic_ref<GCColor>(obj->color)
+                .compare_exchange_strong(expected, GCColor::Gray, std::memory_order_relaxed);
+        }
+
+        static void Blacken(Object *obj)
+        {
+            std::atomic_ref<GCColor>(obj->color).store(GCColor::Black, std::memory_order_relaxed);
+        }
+    };
+
+    /*
+        每个线程有私有栈 (无锁) 和共享栈 (加锁，可被窃取)。
+        私有栈积压较多且共享栈为空时，把较早压入的一半挪到共享栈；
+        自己没活时先取回自己的共享栈，再从别的线程的共享栈偷一半。
+
+        辅助线程在第一次 Drain 时创建并常驻，两轮之间睡在条件变量上，
+        避免每轮回收都付一次建线程 / join 的开销 (这正是停顿里想省掉的部分)。
+
+        着色 (Marks::TryMark) 是原子的抢占，只有抢到的线程扫描该对象，
+        因此对象的子引用不会被重复扫描，扫描本身也无需加锁。
+        标记期间 mutator 停在分配点上，堆不会被改动
+    */
+    class ParallelMarker
+    {
+    private:
+        static constexpr std::size_t ShareThreshold = 64;
+
+        struct alignas(64) Worker
+        {
+            DynArray<Object *> local;
+
+            std::mutex               lock;
+            DynArray<Object *>       shared;
+            std::atomic<std::size_t> sharedSize{0};
+        };
+
+        std::size_t               threadCount;
+        std::unique_ptr<Worker[]> workers;
+        std::atomic<std::size_t>  idleCount{0};
+
+        // 常驻辅助线程：generation 变化即有新一轮，job 以 (函数, 上下文) 形式擦除模板参数
+        DynArray<std::thread>   helpers;
+        std::mutex              poolLock;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::uint64_t           generation = 0;
+        std::size_t             pending    = 0;
+        bool                    stopping   = false;
+        void (*job)(void *, std::size_t) = nullptr;
+        void *jobContext                  = nullptr;
+
+        void helperLoop(std::size_t self)
+        {
+            std::uint64_t seen = 0;
+            while (true)
+            {
+                std::unique_lock guard(poolLock);
+                wake.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen     = generation;
+                auto fn  = job;
+                auto ctx = jobContext;
+                guard.unlock();
+
+                fn(ctx, self);
+
+                guard.lock();
+                if (--pending == 0)
+                    done.notify_one();
+            }
+        }
+
+        static void publish(Worker &w)
+        {
+            std::size_t half = w.local.size() / 2;
+
+            std::lock_guard guard(w.lock);
+            w.shared.insert(w.shared.end(), w.local.begin(), w.local.begin() + half);
+            w.local.erase(w.local.begin(), w.local.begin() + half);
+            w.sharedSize.store(w.shared.size(), std::memory_order_release);
+        }
+
+        // 从 victim 的共享栈取一半 (至少一个) 到 thief 的私有栈
+        static bool take(Worker &victim, Worker &thief)
+        {
+            if (victim.sharedSize.load(std::memory_order_acquire) == 0)
+                return false;
+
+            std::lock_guard guard(victim.lock);
+            std::size_t     n = victim.shared.size();
+            if (n == 0)
+                return false;
+
+            std::size_t count = (n + 1) / 2;
+            thief.local.insert(thief.local.end(), victim.shared.end() - count, victim.shared.end());
+            victim.shared.resize(n - count);
+            victim.sharedSize.store(victim.shared.size(), std::memory_order_release);
+            return true;
+        }
+
+        bool steal(std::size_t self)
+        {
+            for (std::size_t i = 1; i < threadCount; ++i)
+            {
+                if (take(workers[(self + i) % threadCount], workers[self]))
+                    return true;
+            }
+            return false;
+        }
+
+        /*
+            终止检测：线程只在自己的共享栈为空后才进入空闲，而共享栈只由其主人填充，
+            所以全部线程都空闲时不可能还有待处理对象
+        */
+        bool waitForWork()
+        {
+            idleCount.fetch_add(1, std::memory_order_acq_rel);
+            while (true)
+            {
+                for (std::size_t i = 0; i < threadCount; ++i)
+                {
+                    if (workers[i].sharedSize.load(std::memory_order_acquire) != 0)
+                    {
+                        idleCount.fetch_sub(1, std::memory_order_acq_rel);
+                        return true;
+                    }
+                }
+                if (idleCount.load(std::memory_order_acquire) == threadCount)
+                    return false;
+                std::this_thread::yield();
+            }
+        }
+
+        template <typename Scan, typename Marks>
+        void run(std::size_t self, Scan &scan, const Marks &marks)
+        {
+            Worker &w     = workers[self];
+            auto    visit = [&w, &marks](Value &v) {
+                if (v.IsObject() && marks.TryMark(v.AsObject()))
+                    w.local.push_back(v.AsObject());
+            };
+
+            while (true)
+            {
+                while (!w.local.empty())
+                {
+                    Object *obj = w.local.back();
+                    w.local.pop_back();
+
+                    scan(obj, visit);
+                    marks.Blacken(obj);
+
+                    if (w.local.size() >= ShareThreshold
+                        && w.sharedSize.load(std::memory_order_relaxed) == 0)
+                        publish(w);
+                }
+
+                if (take(w, w) || steal(self))
+                    continue;
+                if (!waitForWork())
+                    return;
+            }
+        }
+
+    public:
+        explicit ParallelMarker(std::size_t threads) :
+            threadCount(threads < 1 ? 1 : threads), workers(std::make_unique<Worker[]>(threadCount))
+        {
+        }
+
+        ParallelMarker(const ParallelMarker &)            = delete;
+        ParallelMarker &operator=(const ParallelMarker &) = delete;
+
+        ~ParallelMarker()
+        {
+            {
+                std::lock_guard guard(poolLock);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread &t : helpers)
+                t.join();
+        }
+
+        std::size_t ThreadCount() const
+        {
+            return threadCount;
+        }
+
+        /*
+            排空 grays (已是灰色的对象) 及其可达的全部白色对象，结束时它们都是黑色。
+            scan(Object*, visit) 对对象的每个引用槽位调用 visit(Value&)，
+            marks 提供 TryMark / Blacken (老年代标记位不在对象头里时替换默认的 ColorMarks)。
+            当前线程作为 0 号线程参与，常驻的辅助线程本轮结束后回去睡眠
+        */
+        template <typename Scan, typename Marks = ColorMarks>
+        void Drain(DynArray<Object *> &grays, Scan &&scan, const Marks &marks = {})
+        {
+            for (std::size_t i = 0; i < grays.size(); ++i)
+                workers[i % threadCount].local.push_back(grays[i]);
+            grays.clear();
+            idleCount.store(0, std::memory_order_relaxed);
+
+            if (threadCount == 1)
+            {
+                run(0, scan, marks);
+                return;
+            }
+
+            struct Context
+            {
+                ParallelMarker *self;
+                Scan           &scan;
+                const Marks    &marks;
+            } context{this, scan, marks};
+
+            {
+                std::lock_guard guard(poolLock);
+                job = [](void *ctx, std::size_t self) {
+                    auto *c = static_cast<Context *>(ctx);
+                    c->self->run(self, c->scan, c->marks);
+                };
+                jobContext = &context;
+                pending    = threadCount - 1;
+                ++generation;
+            }
+            if (helpers.empty())
+            {
+                helpers.reserve(threadCount - 1);
+                for (std::size_t i = 1; i < threadCount; ++i)
+                    helpers.emplace_back([this, i] { helperLoop(i); });
+            }
+            else
+            {
+                wake.notify_all();
+            }
+
+            run(0, scan, marks);
+
+            std::unique_lock guard(poolLock);
+            done.wait(guard, [this] { return pending == 0; });
+        }
+    };
+} // namespace Fig
@@ -0,0 +1,153 @@
+/*!
+    @file src/VM/StringTable.hpp
+    @brief 字符串驻留表：VM 内按内容去重的 StringObject 弱引用集合
+*/
+
+#pragma once
+
+#include <Deps/Deps.hpp>
+#include <Object/StringObject.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Fig
+{
+    /*
+        开放寻址、线性探测，槽位只存指针，哈希取对象里缓存的 hash。
+        表不持有对象 (弱引用)：Minor GC 后由 VM 换成晋升后的地址或删掉，
+        老年代标记完成后 Prune 删掉未标记的。删除留墓碑，墓碑过多时原地重建
+    */
+    class StringTable
+    {
+    public:
+        static constexpr std::size_t MaxInternLength = 40;
+
+        /*
+            运行时创建的字符串只驻留形如标识符的短串 (字段名、键)；
+            数字转出来的串、长文本大多各不相同，驻留只会撑大表，它们只缓存哈希
+        */
+        static bool ShouldIntern(const String &data)
+        {
+            std::size_t n = data.length();
+            if (n == 0 || n > MaxInternLength || !CharUtils::isIdentifierStart(data[0]))
+                return false;
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                if (!CharUtils::isIdentifierContinue(data[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        StringObject *Find(const String &data, std::uint32_t hash) const
+        {
+            if (slots.empty())
+                return nullptr;
+            std::size_t mask = slots.size() - 1;
+            for (std::size_t i = hash & mask;; i = (i + 1) & mask)
+            {
+                StringObject *s = slots[i];
+                if (!s)
+                    return nullptr;
+                if (s != Tombstone && s->hash == hash && s->data == data)
+                    return s;
+            }
+        }
+
+        // 调用方保证表中没有相同内容的字符串
+        void Insert(StringObject *str)
+        {
+            if ((used + 1) * 4 > slots.size() * 3)
+                rehash(live + 1);
+
+            std::size_t mask = slots.size() - 1;
+            std::size_t i    = str->hash & mask;
+            while (slots[i] && slots[i] != Tombstone)
+                i = (i + 1) & mask;
+
+            if (!slots[i])
+                ++used;
+            slots[i] = str;
+            ++live;
+        }
+
+        void Remove(StringObject *str)
+        {
+            if (StringObject **slot = slotOf(str))
+            {
+                *slot = Tombstone;
+                --live;
+            }
+        }
+
+        // 对象被搬走 (晋升、疏散)：内容与哈希不变，原槽位换成新地址
+        void Replace(StringObject *from, StringObject *to)
+        {
+            if (StringObject **slot = slotOf(from))
+                *slot = to;
+        }
+
+        // 逐项调用 keep(StringObject *&)，返回 false 的删掉；keep 可以改写指针 (须指向同内容的对象)
+        template <typename F>
+        void Prune(F &&keep)
+        {
+            for (StringObject *&s : slots)
+            {
+                if (!s || s == Tombstone)
+                    continue;
+                if (!keep(s))
+                {
+                    s = Tombstone;
+                    --live;
+                }
+            }
+            if (used > live * 2 + MinCapacity)
+                rehash(live);
+        }
+
+        std::size_t Size() const
+        {
+            return live;
+        }
+
+    private:
+        static constexpr std::size_t MinCapacity = 64;
+
+        static inline StringObject *const Tombstone = reinterpret_cast<StringObject *>(std::uintptr_t{1});
+
+        DynArray<StringObject *> slots; // 容量为 2 的幂
+        std::size_t              live = 0;
+        std::size_t              used = 0; // 存活项 + 墓碑
+
+        StringObject **slotOf(const StringObject *str)
+        {
+            if (slots.empty())
+                return nullptr;
+            std::size_t mask = slots.size() - 1;
+            for (std::size_t i = str->hash & mask; slots[i]; i = (i + 1) & mask)
+            {
+                if (slots[i] == str)
+                    return &slots[i];
+            }
+            return nullptr;
+        }
+
+        // 按 count 个存活项重新分配，负载不超过 1/2
+        void rehash(std::size_t count)
+        {
+            std::size_t capacity = MinCapacity;
+            while (capacity < count * 2)
+                capacity *= 2;
+
+            DynArray<StringObject *> old = std::move(slots);
+            slots.assign(capacity, nullptr);
+            live = used = 0;
+            for (StringObject *s : old)
+            {
+                if (s && s != Tombstone)
+                    Insert(s);
+            }
+        }
+    };
+} // namespace Fig
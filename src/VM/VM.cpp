@@ -6,86 +6,478 @@
 #include <Core/Core.hpp>
 #include <VM/VM.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+
+// == / != 也接受非数值操作数 (字符串按内容，其余按身份)，大小比较只接受数值
+static constexpr bool isEqualityOp(std::string_view op)
+{
+    return op == "==" || op == "!=";
+}
+
+// 与 intArithmetic 同形 (供特化指令的守卫复用)，恒成功
+template <char Op>
+static inline bool doubleArithmetic(double a, double b, Fig::Value &out)
+{
+    if constexpr (Op == '+')
+        out = Fig::Value::FromDouble(a + b);
+    else if constexpr (Op == '-')
+        out = Fig::Value::FromDouble(a - b);
+    else if constexpr (Op == '*')
+        out = Fig::Value::FromDouble(a * b);
+    else if constexpr (Op == '/')
+        out = Fig::Value::FromDouble(a / b);
+    else
+        out = Fig::Value::FromDouble(std::fmod(a, b));
+    return true;
+}
+
+/*
+    Int 与 Int 的算术：+ - * 带 48 位溢出检查；/ % 截断取整，除零或 IntMin / -1 越界。
+    失败时不写 out，由 slowArithmetic 提升为 BigInt 或报错
+*/
+template <char Op>
+static inline bool intArithmetic(std::int64_t a, std::int64_t b, Fig::Value &out)
+{
+    std::int64_t r = 0;
+    bool         ok;
+    if constexpr (Op == '+')
+        ok = Fig::Value::CheckedAdd(a, b, r);
+    else if constexpr (Op == '-')
+        ok = Fig::Value::CheckedSub(a, b, r);
+    else if constexpr (Op == '*')
+        ok = Fig::Value::CheckedMul(a, b, r);
+    else
+    {
+        if (b == 0)
+            return false;
+        r  = Op == '/' ? a / b : a % b;
+        ok = Fig::Value::FitsInt(r);
+    }
+    if (ok) [[likely]]
+        out = Fig::Value::FromInt(r);
+    return ok;
+}
+
+// 慢路径的错误 (除零、类型错误、OutOfMemory) 直接结束执行
+#define SLOW_ARITHMETIC(dst, lhs, rhs, op)                                                         \
+    {                                                                                              \
+        auto slow = slowArithmetic(#op[0], lhs, rhs);                                              \
+        if (!slow) [[unlikely]]                                                                    \
+            return std::unexpected(slow.error());                                                  \
+        dst = *slow;                                                                               \
+    }
+
+// 数值四路分发: int/int, double/double, int/double, double/int
+#define NUMERIC_ARITHMETIC(dst, lhs, rhs, op)                                                      \
+    if ((lhs).IsInt() && (rhs).IsInt()) [[likely]]                                                 \
+    {                                                                                              \
+        if (!intArithmetic<#op[0]>((lhs).AsInt(), (rhs).AsInt(), dst)) [[unlikely]]                \
+            SLOW_ARITHMETIC(dst, lhs, rhs, op);                                                    \
+    }                                                                                              \
+    else if ((lhs).IsDouble() && (rhs).IsDouble()) [[likely]]                                      \
+    {                                                                                              \
+        doubleArithmetic<#op[0]>((lhs).AsDouble(), (rhs).AsDouble(), dst);                         \
+    }                                                                                              \
+    else if ((lhs).IsInt() && (rhs).IsDouble()) [[likely]]                                         \
+    {                                                                                              \
+        doubleArithmetic<#op[0]>(static_cast<double>((lhs).AsInt()), (rhs).AsDouble(), dst);       \
+    }                                                                                              \
+    else if ((lhs).IsDouble() && (rhs).IsInt()) [[likely]]                                         \
+    {                                                                                              \
+        doubleArithmetic<#op[0]>((lhs).AsDouble(), static_cast<double>((rhs).AsInt()), dst);       \
+    }                                                                                              \
+    else                                                                                           \
+    {                                                                                              \
+        SLOW_ARITHMETIC(dst, lhs, rhs, op);                                                        \
+    }
+
+#define NUMERIC_COMPARE(cond, lhs, rhs, op)                                                        \
+    if ((lhs).IsInt() && (rhs).IsInt()) [[likely]]                                                 \
+    {                                                                                              \
+        cond = (lhs).AsInt() op(rhs).AsInt();                                                      \
+    }                                                                                              \
+    else if ((lhs).IsDouble() && (rhs).IsDouble()) [[likely]]                                      \
+    {                                                                                              \
+        cond = (lhs).AsDouble() op(rhs).AsDouble();                                                \
+    }                                                                                              \
+    else if ((lhs).IsInt() && (rhs).IsDouble()) [[likely]]                                         \
+    {                                                                                              \
+        cond = (lhs).AsInt() op(rhs).AsDouble();                                                   \
+    }                                                                                              \
+    else if ((lhs).IsDouble() && (rhs).IsInt()) [[likely]]                                         \
+    {                                                                                              \
+        cond = (lhs).AsDouble() op(rhs).AsInt();                                                   \
+    }                                                                                              \
+    else if (isNumber(lhs) && isNumber(rhs))                                                       \
+    {                                                                                              \
+        cond = compareNumbers(lhs, rhs) op 0; /* 有 BigInt 参与 */                                 \
+    }                                                                                              \
+    else if constexpr (isEqualityOp(#op))                                                          \
+    {                                                                                              \
+        cond = valuesEqual(lhs, rhs) op true;                                                      \
+    }                                                                                              \
+    else                                                                                           \
+    {                                                                                              \
+        assert(false && "VM Runtime Error: Unsupported types for comparison");                     \
+        cond = false;                                                                              \
+    }
+
 #define BINARY_ARITHMETIC_OP(opName, op)                                                           \
     do_##opName:                                                                                   \
     {                                                                                              \
         std::uint8_t a   = decodeA(inst);                                                          \
-        std::uint8_t b   = decodeB(inst);                                                          \
-        std::uint8_t c   = decodeC(inst);                                                          \
-        Value        lhs = currentFrame->registerBase[b];                                          \
-        Value        rhs = currentFrame->registerBase[c];                                          \
-        if (lhs.IsInt() && rhs.IsInt()) [[likely]]                                                 \
+        Value        lhs = currentFrame->registerBase[decodeB(inst)];                              \
+        Value        rhs = currentFrame->registerBase[decodeC(inst)];                              \
+        NUMERIC_ARITHMETIC(currentFrame->registerBase[a], lhs, rhs, op);                           \
+        DISPATCH();                                                                                \
+    }
+
+#define BINARY_COMPARE_OP(opName, op)                                                              \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        std::uint8_t a   = decodeA(inst);                                                          \
+        Value        lhs = currentFrame->registerBase[decodeB(inst)];                              \
+        Value        rhs = currentFrame->registerBase[decodeC(inst)];                              \
+        bool         cond;                                                                         \
+        NUMERIC_COMPARE(cond, lhs, rhs, op);                                                       \
+        currentFrame->registerBase[a] = cond ? Value::GetTrueInstance() : Value::GetFalseInstance();\
+        DISPATCH();                                                                                \
+    }
+
+// 比较-跳转融合: 条件不成立时跳转 (sC)，不写回寄存器
+#define COMPARE_JMP_OP(opName, op)                                                                 \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        Value lhs = currentFrame->registerBase[decodeA(inst)];                                     \
+        Value rhs = currentFrame->registerBase[decodeB(inst)];                                     \
+        bool  cond;                                                                                \
+        NUMERIC_COMPARE(cond, lhs, rhs, op);                                                       \
+        if (!cond)                                                                                 \
         {                                                                                          \
-            currentFrame->registerBase[a] = Value::FromInt(lhs.AsInt() op rhs.AsInt());            \
+            currentFrame->ip += decodeSC(inst);                                                    \
         }                                                                                          \
-        else if (lhs.IsDouble() && rhs.IsDouble()) [[likely]]                                      \
+        DISPATCH();                                                                                \
+    }
+
+// 静态类型为 Int 的操作数也可能是溢出后提升的 BigInt，IntFast 指令同样按 tag 分发 (Int/Int 在最前)
+#define INT_COMPARE_OP(opName, op)                                                                 \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        std::uint8_t a = decodeA(inst);                                                            \
+        Value        l = currentFrame->registerBase[decodeB(inst)];                                \
+        Value        r = currentFrame->registerBase[decodeC(inst)];                                \
+        bool         cond;                                                                         \
+        NUMERIC_COMPARE(cond, l, r, op);                                                           \
+        currentFrame->registerBase[a] = cond ? Value::GetTrueInstance() : Value::GetFalseInstance();\
+        DISPATCH();                                                                                \
+    }
+
+#define INT_COMPARE_JMP_OP(opName, op)                                                             \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        Value l = currentFrame->registerBase[decodeA(inst)];                                       \
+        Value r = currentFrame->registerBase[decodeB(inst)];                                       \
+        bool  cond;                                                                                \
+        NUMERIC_COMPARE(cond, l, r, op);                                                           \
+        if (!cond)                                                                                 \
         {                                                                                          \
-            currentFrame->registerBase[a] = Value::FromDouble(lhs.AsDouble() op rhs.AsDouble());   \
+            currentFrame->ip += decodeSC(inst);                                                    \
         }                                                                                          \
-        else if (lhs.IsInt() && rhs.IsDouble()) [[likely]]                                         \
+        DISPATCH();                                                                                \
+    }
+
+// 立即数操作数: A = R[B] op sC
+#define ARITHMETIC_IMM_OP(opName, op)                                                              \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        std::uint8_t a   = decodeA(inst);                                                          \
+        Value        lhs = currentFrame->registerBase[decodeB(inst)];                              \
+        std::int8_t  imm = decodeSC(inst);                                                         \
+        if (lhs.IsInt()) [[likely]]                                                                \
         {                                                                                          \
-            currentFrame->registerBase[a] = Value::FromDouble(lhs.AsInt() op rhs.AsDouble());      \
+            if (!intArithmetic<#op[0]>(lhs.AsInt(), imm, currentFrame->registerBase[a])) [[unlikely]]\
+                SLOW_ARITHMETIC(currentFrame->registerBase[a], lhs, Value::FromInt(imm), op);      \
         }                                                                                          \
-        else if (lhs.IsDouble() && rhs.IsInt()) [[likely]]                                         \
+        else if (lhs.IsDouble())                                                                   \
         {                                                                                          \
-            currentFrame->registerBase[a] = Value::FromDouble(lhs.AsDouble() op rhs.AsInt());      \
+            doubleArithmetic<#op[0]>(lhs.AsDouble(), imm, currentFrame->registerBase[a]);          \
         }                                                                                          \
         else                                                                                       \
         {                                                                                          \
-            assert(false && "VM Runtime Error: Unsupported types for arithmetic operation");       \
+            SLOW_ARITHMETIC(currentFrame->registerBase[a], lhs, Value::FromInt(imm), op);          \
         }                                                                                          \
         DISPATCH();                                                                                \
     }
 
-#define BINARY_COMPARE_OP(opName, op)                                                              \
+// 常量池操作数: A = R[B] op K[C]
+#define ARITHMETIC_CONST_OP(opName, op)                                                            \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        std::uint8_t a   = decodeA(inst);                                                          \
+        Value        lhs = currentFrame->registerBase[decodeB(inst)];                              \
+        Value        rhs = currentFrame->getConstant(decodeC(inst));                               \
+        NUMERIC_ARITHMETIC(currentFrame->registerBase[a], lhs, rhs, op);                           \
+        DISPATCH();                                                                                \
+    }
+
+// 非数值与整数立即数比较：== 恒不成立，!= 恒成立
+#define COMPARE_IMM(cond, lhs, imm, op)                                                            \
+    if ((lhs).IsInt()) [[likely]]                                                                  \
+    {                                                                                              \
+        cond = (lhs).AsInt() op(imm);                                                              \
+    }                                                                                              \
+    else if ((lhs).IsDouble())                                                                     \
+    {                                                                                              \
+        cond = (lhs).AsDouble() op(imm);                                                           \
+    }                                                                                              \
+    else if (IsBigInt(lhs))                                                                        \
+    {                                                                                              \
+        cond = compareNumbers(lhs, Value::FromInt(imm)) op 0;                                      \
+    }                                                                                              \
+    else if constexpr (isEqualityOp(#op))                                                          \
+    {                                                                                              \
+        cond = false op true;                                                                      \
+    }                                                                                              \
+    else                                                                                           \
+    {                                                                                              \
+        assert(false && "VM Runtime Error: Unsupported types for comparison");                     \
+        cond = false;                                                                              \
+    }
+
+#define COMPARE_IMM_OP(opName, op)                                                                 \
     do_##opName:                                                                                   \
     {                                                                                              \
         std::uint8_t a   = decodeA(inst);                                                          \
-        std::uint8_t b   = decodeB(inst);                                                          \
-        std::uint8_t c   = decodeC(inst);                                                          \
-        Value        lhs = currentFrame->registerBase[b];                                          \
-        Value        rhs = currentFrame->registerBase[c];                                          \
+        Value        lhs = currentFrame->registerBase[decodeB(inst)];                              \
+        bool         cond;                                                                         \
+        COMPARE_IMM(cond, lhs, decodeSC(inst), op);                                                \
+        currentFrame->registerBase[a] = cond ? Value::GetTrueInstance() : Value::GetFalseInstance();\
+        DISPATCH();                                                                                \
+    }
+
+#define COMPARE_CONST_OP(opName, op)                                                               \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        std::uint8_t a   = decodeA(inst);                                                          \
+        Value        lhs = currentFrame->registerBase[decodeB(inst)];                              \
+        Value        rhs = currentFrame->getConstant(decodeC(inst));                               \
+        bool         cond;                                                                         \
+        NUMERIC_COMPARE(cond, lhs, rhs, op);                                                       \
+        currentFrame->registerBase[a] = cond ? Value::GetTrueInstance() : Value::GetFalseInstance();\
+        DISPATCH();                                                                                \
+    }
+
+// 立即数比较-跳转融合: if !(R[A] op sB) ip += sC
+#define COMPARE_IMM_JMP_OP(opName, op)                                                             \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        Value lhs = currentFrame->registerBase[decodeA(inst)];                                     \
+        bool  cond;                                                                                \
+        COMPARE_IMM(cond, lhs, static_cast<std::int8_t>(decodeB(inst)), op);                       \
+        if (!cond)                                                                                 \
+        {                                                                                          \
+            currentFrame->ip += decodeSC(inst);                                                    \
+        }                                                                                          \
+        DISPATCH();                                                                                \
+    }
+
+// 常量比较-跳转融合: if !(R[A] op K[B]) ip += sC
+#define COMPARE_CONST_JMP_OP(opName, op)                                                           \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        Value lhs = currentFrame->registerBase[decodeA(inst)];                                     \
+        Value rhs = currentFrame->getConstant(decodeB(inst));                                      \
+        bool  cond;                                                                                \
+        NUMERIC_COMPARE(cond, lhs, rhs, op);                                                       \
+        if (!cond)                                                                                 \
+        {                                                                                          \
+            currentFrame->ip += decodeSC(inst);                                                    \
+        }                                                                                          \
+        DISPATCH();                                                                                \
+    }
+
+// 可特化的泛型算术: Int/Int 与 Double/Double 分别计数，稳定后改写为 opName##Int / opName##Double
+#define QUICKENING_ARITHMETIC_OP(opName, op)                                                       \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        std::uint8_t a   = decodeA(inst);                                                          \
+        Value        lhs = currentFrame->registerBase[decodeB(inst)];                              \
+        Value        rhs = currentFrame->registerBase[decodeC(inst)];                              \
+        if (lhs.IsInt() && rhs.IsInt()                                                             \
+            && intArithmetic<#op[0]>(lhs.AsInt(), rhs.AsInt(), currentFrame->registerBase[a])) [[likely]]\
+        {                                                                                          \
+            quickenHit(inst, OpCode::opName##Int);                                                 \
+        }                                                                                          \
+        else if (lhs.IsDouble() && rhs.IsDouble())                                                 \
+        {                                                                                          \
+            doubleArithmetic<#op[0]>(lhs.AsDouble(), rhs.AsDouble(), currentFrame->registerBase[a]);\
+            quickenHit(inst, OpCode::opName##Double);                                              \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            NUMERIC_ARITHMETIC(currentFrame->registerBase[a], lhs, rhs, op);                       \
+            quickenMiss();                                                                         \
+        }                                                                                          \
+        DISPATCH();                                                                                \
+    }
+
+// 特化算术: 单一类型守卫，失败 (含 Int 溢出) 时改回泛型指令并由其重新执行
+#define QUICK_ARITHMETIC_OP(opName, generic, is, as, arith, op)                                    \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        Value lhs = currentFrame->registerBase[decodeB(inst)];                                     \
+        Value rhs = currentFrame->registerBase[decodeC(inst)];                                     \
+        if (lhs.is() && rhs.is() && arith<#op[0]>(lhs.as(), rhs.as(), currentFrame->registerBase[decodeA(inst)]))\
+            [[likely]]                                                                             \
+        {                                                                                          \
+            DISPATCH();                                                                            \
+        }                                                                                          \
+        dequicken(inst, OpCode::generic);                                                          \
+        goto do_##generic;                                                                         \
+    }
+
+#define QUICKENING_COMPARE_OP(opName, op)                                                          \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        std::uint8_t a   = decodeA(inst);                                                          \
+        Value        lhs = currentFrame->registerBase[decodeB(inst)];                              \
+        Value        rhs = currentFrame->registerBase[decodeC(inst)];                              \
+        bool         cond;                                                                         \
         if (lhs.IsInt() && rhs.IsInt()) [[likely]]                                                 \
         {                                                                                          \
-            currentFrame->registerBase[a] = (lhs.AsInt() op rhs.AsInt()) ?                         \
-                                                Value::GetTrueInstance() :                         \
-                                                Value::GetFalseInstance();                         \
+            cond = lhs.AsInt() op rhs.AsInt();                                                     \
+            quickenHit(inst, OpCode::opName##Int);                                                 \
+        }                                                                                          \
+        else if (lhs.IsDouble() && rhs.IsDouble())                                                 \
+        {                                                                                          \
+            cond = lhs.AsDouble() op rhs.AsDouble();                                               \
+            quickenHit(inst, OpCode::opName##Double);                                              \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            NUMERIC_COMPARE(cond, lhs, rhs, op);                                                   \
+            quickenMiss();                                                                         \
         }                                                                                          \
-        else if (lhs.IsDouble() && rhs.IsDouble()) [[likely]]                                      \
+        currentFrame->registerBase[a] = cond ? Value::GetTrueInstance() : Value::GetFalseInstance();\
+        DISPATCH();                                                                                \
+    }
+
+#define QUICK_COMPARE_OP(opName, generic, is, as, op)                                              \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        Value lhs = currentFrame->registerBase[decodeB(inst)];                                     \
+        Value rhs = currentFrame->registerBase[decodeC(inst)];                                     \
+        if (lhs.is() && rhs.is()) [[likely]]                                                       \
         {                                                                                          \
-            currentFrame->registerBase[a] = (lhs.AsDouble() op rhs.AsDouble()) ?                   \
-                                                Value::GetTrueInstance() :                         \
-                                                Value::GetFalseInstance();                         \
+            currentFrame->registerBase[decodeA(inst)] =                                            \
+                (lhs.as() op rhs.as()) ? Value::GetTrueInstance() : Value::GetFalseInstance();     \
+            DISPATCH();                                                                            \
         }                                                                                          \
-        else if (lhs.IsInt() && rhs.IsDouble()) [[likely]]                                         \
+        dequicken(inst, OpCode::generic);                                                          \
+        goto do_##generic;                                                                         \
+    }
+
+#define QUICKENING_COMPARE_JMP_OP(opName, op)                                                      \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        Value lhs = currentFrame->registerBase[decodeA(inst)];                                     \
+        Value rhs = currentFrame->registerBase[decodeB(inst)];                                     \
+        bool  cond;                                                                                \
+        if (lhs.IsInt() && rhs.IsInt()) [[likely]]                                                 \
         {                                                                                          \
-            currentFrame->registerBase[a] = (lhs.AsInt() op rhs.AsDouble()) ?                      \
-                                                Value::GetTrueInstance() :                         \
-                                                Value::GetFalseInstance();                         \
+            cond = lhs.AsInt() op rhs.AsInt();                                                     \
+            quickenHit(inst, OpCode::opName##Int);                                                 \
         }                                                                                          \
-        else if (lhs.IsDouble() && rhs.IsInt()) [[likely]]                                         \
+        else if (lhs.IsDouble() && rhs.IsDouble())                                                 \
         {                                                                                          \
-            currentFrame->registerBase[a] = (lhs.AsDouble() op rhs.AsInt()) ?                      \
-                                                Value::GetTrueInstance() :                         \
-                                                Value::GetFalseInstance();                         \
+            cond = lhs.AsDouble() op rhs.AsDouble();                                               \
+            quickenHit(inst, OpCode::opName##Double);                                              \
         }                                                                                          \
         else                                                                                       \
         {                                                                                          \
-            assert(false && "VM Runtime Error: Unsupported types for comparison");                 \
+            NUMERIC_COMPARE(cond, lhs, rhs, op);                                                   \
+            quickenMiss();                                                                         \
+        }                                                                                          \
+        if (!cond)                                                                                 \
+        {                                                                                          \
+            currentFrame->ip += decodeSC(inst);                                                    \
         }                                                                                          \
         DISPATCH();                                                                                \
     }
 
+#define QUICK_COMPARE_JMP_OP(opName, generic, is, as, op)                                          \
+    do_##opName:                                                                                   \
+    {                                                                                              \
+        Value lhs = currentFrame->registerBase[decodeA(inst)];                                     \
+        Value rhs = currentFrame->registerBase[decodeB(inst)];                                     \
+        if (lhs.is() && rhs.is()) [[likely]]                                                       \
+        {                                                                                          \
+            if (!(lhs.as() op rhs.as()))                                                           \
+            {                                                                                      \
+                currentFrame->ip += decodeSC(inst);                                                \
+            }                                                                                      \
+            DISPATCH();                                                                            \
+        }                                                                                          \
+        dequicken(inst, OpCode::generic);                                                          \
+        goto do_##generic;                                                                         \
+    }
+
 namespace Fig
 {
     Result<Value, Error> VM::Execute(CompiledModule *compiledModule)
     {
         Proto *entry = compiledModule->protos[0];
-        (void) pushFrame(entry, registers); // 刚开始执行寄存器不会溢出
+
+        if (globals.size() < compiledModule->globalCount)
+        {
+            globals.resize(compiledModule->globalCount); // 新槽位为 Null
+        }
+        internModuleStrings(compiledModule);
+
+        for (Proto *proto : compiledModule->protos)
+        {
+            if (proto->quicken.size() != proto->code.size())
+            {
+                proto->quicken.assign(proto->code.size(), {});
+            }
+
+            if (proto->callCache.empty())
+            {
+                bool hasCallSite = std::ranges::any_of(proto->code, [](Instruction inst) {
+                    auto op = static_cast<OpCode>(inst & 0xFF);
+                    return op == OpCode::Call || op == OpCode::TailCall;
+                });
+                if (hasCallSite)
+                {
+                    proto->callCache.resize(proto->code.size());
+                    callSiteProtos.push_back(proto);
+                }
+            }
+
+            if (proto->fieldCache.empty())
+            {
+                bool hasFieldSite = std::ranges::any_of(proto->code, [](Instruction inst) {
+                    auto op = static_cast<OpCode>(inst & 0xFF);
+                    return op == OpCode::GetFieldK || op == OpCode::SetFieldK;
+                });
+                if (hasFieldSite)
+                    proto->fieldCache.resize(proto->code.size());
+            }
+        }
+
+        resetFrames(); // Repl 会复用同一个 VM
+        if (!pushFrame(nullptr, entry, 0))
+        {
+            return std::unexpected(Error(ErrorType::StackOverflow,
+                "entry proto needs more registers than the stack limit",
+                "",
+                {}));
+        }
 
         // 对齐 Bytecode.hpp 中的 OpCode 顺序
         static const void *dispatchTable[] = {&&do_Exit,
-            &&do_Exit_MaxRecursionDepthExceeded,
 
             &&do_LoadK,
             &&do_LoadTrue,
@@ -95,12 +487,40 @@ namespace Fig
             &&do_FastCall,
             &&do_Call,
             &&do_Return,
+            &&do_TailFastCall,
+            &&do_TailCall,
+            &&do_CallNative,
 
             &&do_LoadFn,
+            &&do_LoadNative,
 
             &&do_Jmp,
             &&do_JmpIfFalse,
 
+            &&do_JmpIfNotLess,
+            &&do_JmpIfNotLessEqual,
+            &&do_JmpIfNotEqual,
+            &&do_JmpIfEqual,
+
+            &&do_IntJmpIfNotLess,
+            &&do_IntJmpIfNotLessEqual,
+            &&do_IntJmpIfNotEqual,
+            &&do_IntJmpIfEqual,
+
+            &&do_JmpIfNotEqualI,
+            &&do_JmpIfEqualI,
+            &&do_JmpIfNotGreaterI,
+            &&do_JmpIfNotLessI,
+            &&do_JmpIfNotGreaterEqualI,
+            &&do_JmpIfNotLessEqualI,
+
+            &&do_JmpIfNotEqualK,
+            &&do_JmpIfEqualK,
+            &&do_JmpIfNotGreaterK,
+            &&do_JmpIfNotLessK,
+            &&do_JmpIfNotGreaterEqualK,
+            &&do_JmpIfNotLessEqualK,
+
             &&do_Mov,
 
             &&do_Add,
@@ -115,6 +535,34 @@ namespace Fig
             &&do_IntFastMul,
             &&do_IntFastDiv,
 
+            &&do_IntFastEqual,
+            &&do_IntFastNotEqual,
+            &&do_IntFastGreater,
+            &&do_IntFastLess,
+            &&do_IntFastGreaterEqual,
+            &&do_IntFastLessEqual,
+
+            &&do_AddI,
+            &&do_SubI,
+            &&do_MulI,
+            &&do_AddK,
+            &&do_SubK,
+            &&do_MulK,
+
+            &&do_EqualI,
+            &&do_NotEqualI,
+            &&do_GreaterI,
+            &&do_LessI,
+            &&do_GreaterEqualI,
+            &&do_LessEqualI,
+
+            &&do_EqualK,
+            &&do_NotEqualK,
+            &&do_GreaterK,
+            &&do_LessK,
+            &&do_GreaterEqualK,
+            &&do_LessEqualK,
+
             &&do_Equal,
             &&do_NotEqual,
             &&do_Greater,
@@ -122,11 +570,39 @@ namespace Fig
             &&do_GreaterEqual,
             &&do_LessEqual,
 
+            &&do_AddInt,
+            &&do_AddDouble,
+            &&do_SubInt,
+            &&do_SubDouble,
+            &&do_MulInt,
+            &&do_MulDouble,
+
+            &&do_GreaterInt,
+            &&do_GreaterDouble,
+            &&do_LessInt,
+            &&do_LessDouble,
+            &&do_GreaterEqualInt,
+            &&do_GreaterEqualDouble,
+            &&do_LessEqualInt,
+            &&do_LessEqualDouble,
+
+            &&do_JmpIfNotLessInt,
+            &&do_JmpIfNotLessDouble,
+            &&do_JmpIfNotLessEqualInt,
+            &&do_JmpIfNotLessEqualDouble,
+
             &&do_GetGlobal,
             &&do_SetGlobal,
             &&do_GetUpval,
             &&do_SetUpval,
             &&do_Copy,
+            &&do_GetCapture,
+
+            &&do_GetField,
+            &&do_SetField,
+            &&do_GetFieldK,
+            &&do_SetFieldK,
+            &&do_NewInstance,
 
             &&do_Count};
 
@@ -139,22 +615,28 @@ namespace Fig
         goto *dispatchTable[inst & 0xFF];                                                          \
     } while (0)
 
+#define TRACE_ENTER(backEdgePc)                                                                    \
+    do                                                                                             \
+    {                                                                                              \
+        if (config.enableTraceJit) [[unlikely]]                                                    \
+            traceEnter(backEdgePc);                                                                \
+    } while (0)
+
+#define JIT_ENTER(countHot)                                                                        \
+    do                                                                                             \
+    {                                                                                              \
+        if (config.enableJit) [[unlikely]]                                                         \
+            jitEnter(countHot);                                                                    \
+    } while (0)
+
         // 引擎点火!! :3
+        JIT_ENTER(true);
         DISPATCH();
 
     do_Exit: {
         return Value::FromInt(decodeSBx(inst));
     }
 
-    do_Exit_MaxRecursionDepthExceeded: {
-        CoreIO::GetStdErr() << std::format(
-            "Oops! max recursion depth limit {} exceeded in Fn `{}` , exiting...\n",
-            MAX_RECURSION_DEPTH,
-            (currentFrame - 1)->proto->name); // pushFrame失败了，但currentFrame仍然移动，所以
-                                              // (currentFrame - 1)是 lastFrame
-        std::exit(static_cast<int>(MAX_RECURSION_DEPTH));
-    }
-
     do_LoadK: {
         std::uint8_t  a               = decodeA(inst);
         std::uint16_t bx              = decodeBx(inst);
@@ -185,23 +667,33 @@ namespace Fig
         Proto       *proto   = compiledModule->protos[a];
         std::uint8_t baseReg = decodeB(inst);
 
-        currentFrame->ip = pushFrame(proto, currentFrame->registerBase + baseReg);
+        if (!pushFrame(proto, baseReg)) [[unlikely]]
+            return std::unexpected(stackOverflowError());
 
+        JIT_ENTER(true);
         DISPATCH();
     }
 
     do_Call: {
-        // TODO: FunctionObject 动态解包
-
         std::uint8_t a       = decodeA(inst);
         std::uint8_t baseReg = decodeB(inst);
 
         Value callee = currentFrame->registerBase[a];
 
-        FunctionObject *closure = nullptr;
-
-        if (!callee.IsObject())
+        const CallSiteCache *ic = lookupCallSite(callee);
+        if (!ic) [[unlikely]]
         {
+            if (callee.IsObject() && callee.AsObject()->isNativeFunction())
+            {
+                auto        *native = static_cast<NativeFunctionObject *>(callee.AsObject());
+                std::uint8_t argc   = decodeC(inst);
+                if (native->arity >= 0 && native->arity != argc)
+                    return std::unexpected(nativeArityError(native, argc));
+                if (auto r = callNative(native, baseReg, argc); !r)
+                    return std::unexpected(r.error());
+                DISPATCH();
+            }
+
             size_t ipIdx = currentFrame->ip - currentFrame->proto->code.data();
 
             return std::unexpected(Error(ErrorType::TypeError,
@@ -209,23 +701,12 @@ namespace Fig
                 "none",
                 *currentFrame->proto->locations[ipIdx]));
         }
-        else
-        {
-            Object *obj = callee.AsObject();
-            if (!obj->isFunction())
-            {
-                size_t ipIdx = currentFrame->ip - currentFrame->proto->code.data();
 
-                return std::unexpected(Error(ErrorType::TypeError,
-                    std::format("Object `{}` is not callable", callee.ToString()),
-                    "none",
-                    *currentFrame->proto->locations[ipIdx]));
-            }
-            closure = static_cast<FunctionObject *>(obj);
-        }
-
-        currentFrame->ip = pushFrame(closure, currentFrame->registerBase + baseReg);
+        std::size_t baseOffset = (currentFrame->registerBase - stack.data()) + baseReg;
+        if (!pushFrame(ic->callee, ic->proto, baseOffset)) [[unlikely]]
+            return std::unexpected(stackOverflowError());
 
+        JIT_ENTER(true);
         DISPATCH();
     }
 
@@ -239,6 +720,74 @@ namespace Fig
         currentFrame->registerBase[0] = retVal;
         popFrame();
 
+        JIT_ENTER(false);
+        DISPATCH();
+    }
+
+    do_TailFastCall: {
+        std::uint8_t a       = decodeA(inst);
+        Proto       *proto   = compiledModule->protos[a];
+        std::uint8_t baseReg = decodeB(inst);
+        std::uint8_t argc    = decodeC(inst);
+
+        if (!tailFrame(nullptr, proto, baseReg, argc)) [[unlikely]]
+            return std::unexpected(stackOverflowError());
+
+        JIT_ENTER(true);
+        DISPATCH();
+    }
+
+    do_TailCall: {
+        std::uint8_t a       = decodeA(inst);
+        std::uint8_t baseReg = decodeB(inst);
+        std::uint8_t argc    = decodeC(inst);
+
+        Value callee = currentFrame->registerBase[a];
+
+        const CallSiteCache *ic = lookupCallSite(callee);
+        if (!ic) [[unlikely]]
+        {
+            if (callee.IsObject() && callee.AsObject()->isNativeFunction())
+            {
+                // 原生函数不占帧：按普通调用执行后把结果作为当前帧的返回值
+                auto *native = static_cast<NativeFunctionObject *>(callee.AsObject());
+                if (native->arity >= 0 && native->arity != argc)
+                    return std::unexpected(nativeArityError(native, argc));
+                if (auto r = callNative(native, baseReg, argc); !r)
+                    return std::unexpected(r.error());
+
+                Value retVal = currentFrame->registerBase[baseReg];
+                closeUpvalues(currentFrame->registerBase);
+                currentFrame->registerBase[0] = retVal;
+                popFrame();
+
+                JIT_ENTER(false);
+                DISPATCH();
+            }
+
+            size_t ipIdx = currentFrame->ip - currentFrame->proto->code.data();
+
+            return std::unexpected(Error(ErrorType::TypeError,
+                std::format("Object `{}` is not callable", callee.ToString()),
+                "none",
+                *currentFrame->proto->locations[ipIdx]));
+        }
+
+        if (!tailFrame(ic->callee, ic->proto, baseReg, argc)) [[unlikely]]
+            return std::unexpected(stackOverflowError());
+
+        JIT_ENTER(true);
+
+        DISPATCH();
+    }
+
+    do_CallNative: {
+        NativeFunctionObject *native  = Std::GetNativeObject(decodeA(inst));
+        std::uint8_t          baseReg = decodeB(inst);
+        std::uint8_t          argc    = decodeC(inst);
+
+        if (auto r = callNative(native, baseReg, argc); !r) [[unlikely]]
+            return std::unexpected(r.error());
         DISPATCH();
     }
 
@@ -249,10 +798,12 @@ namespace Fig
         Proto *p = compiledModule->protos[bx];
 
         size_t upValSize = p->upvalues.size();
-        size_t extraSize = upValSize * sizeof(Upvalue *);
+        size_t extraSize = upValSize * sizeof(UpvalueSlot);
 
         FunctionObject *closure =
             (FunctionObject *) allocateObject<FunctionObject>(ObjectType::Function, extraSize);
+        if (!closure) [[unlikely]]
+            return std::unexpected(outOfMemoryError(sizeof(FunctionObject) + extraSize));
 
         // CoreIO::GetStdErr() << "DEBUG: p->name = " << p->name << '\n';
         new (&closure->name) String(p->name); // String非平凡类型，有自己的构造函数
@@ -263,7 +814,15 @@ namespace Fig
         for (size_t i = 0; i < closure->upvalueCount; ++i)
         {
             auto &info = p->upvalues[i];
-            if (info.isLocal)
+            if (info.byValue)
+            {
+                // 按值捕获：外层的同一变量也一定是按值捕获
+                closure->upvalues[i].value = info.isLocal
+                                                 ? currentFrame->registerBase[info.index]
+                                                 : currentFrame->closure->upvalues[info.index].value;
+                writeBarrier(closure, closure->upvalues[i].value);
+            }
+            else if (info.isLocal)
             {
                 Value   *targetSlot = &currentFrame->registerBase[info.index];
                 Upvalue *prev       = nullptr;
@@ -278,7 +837,7 @@ namespace Fig
                 if (curr != nullptr && curr->location == targetSlot)
                 {
                     // 如果别的闭包已经捕获了这个槽位，共享物理指针
-                    closure->upvalues[i] = curr;
+                    closure->upvalues[i].ref = curr;
                     ++curr->refCount;
                 }
                 else
@@ -294,12 +853,15 @@ namespace Fig
                         openUpvalues = uv;
                     else
                         prev->next = uv;
-                    closure->upvalues[i] = uv;
+                    closure->upvalues[i].ref = uv;
                 }
             }
             else
             {
-                closure->upvalues[i] = currentFrame->closure->upvalues[info.index];
+                // 继承外层闭包的 Upvalue：同样计一次引用，外层闭包先回收时不会把它释放
+                Upvalue *uv              = currentFrame->closure->upvalues[info.index].ref;
+                closure->upvalues[i].ref = uv;
+                ++uv->refCount;
             }
         }
 
@@ -307,9 +869,22 @@ namespace Fig
         DISPATCH();
     }
 
+    do_LoadNative: {
+        std::uint8_t  a               = decodeA(inst);
+        std::uint16_t bx              = decodeBx(inst);
+        currentFrame->registerBase[a] = Value::FromObject(Std::GetNativeObject(bx));
+        DISPATCH();
+    }
+
     do_Jmp: {
         std::int16_t sbx = decodeSBx(inst);
         currentFrame->ip += sbx;
+        if (sbx < 0)
+        {
+            // 回边
+            TRACE_ENTER(static_cast<std::uint32_t>(currentFrame->ip - currentFrame->proto->code.data() - 1 - sbx));
+            JIT_ENTER(true);
+        }
         DISPATCH();
     }
 
@@ -324,6 +899,30 @@ namespace Fig
         DISPATCH();
     }
 
+        QUICKENING_COMPARE_JMP_OP(JmpIfNotLess, <);
+        QUICKENING_COMPARE_JMP_OP(JmpIfNotLessEqual, <=);
+        COMPARE_JMP_OP(JmpIfNotEqual, ==);
+        COMPARE_JMP_OP(JmpIfEqual, !=);
+
+        INT_COMPARE_JMP_OP(IntJmpIfNotLess, <);
+        INT_COMPARE_JMP_OP(IntJmpIfNotLessEqual, <=);
+        INT_COMPARE_JMP_OP(IntJmpIfNotEqual, ==);
+        INT_COMPARE_JMP_OP(IntJmpIfEqual, !=);
+
+        COMPARE_IMM_JMP_OP(JmpIfNotEqualI, ==);
+        COMPARE_IMM_JMP_OP(JmpIfEqualI, !=);
+        COMPARE_IMM_JMP_OP(JmpIfNotGreaterI, >);
+        COMPARE_IMM_JMP_OP(JmpIfNotLessI, <);
+        COMPARE_IMM_JMP_OP(JmpIfNotGreaterEqualI, >=);
+        COMPARE_IMM_JMP_OP(JmpIfNotLessEqualI, <=);
+
+        COMPARE_CONST_JMP_OP(JmpIfNotEqualK, ==);
+        COMPARE_CONST_JMP_OP(JmpIfEqualK, !=);
+        COMPARE_CONST_JMP_OP(JmpIfNotGreaterK, >);
+        COMPARE_CONST_JMP_OP(JmpIfNotLessK, <);
+        COMPARE_CONST_JMP_OP(JmpIfNotGreaterEqualK, >=);
+        COMPARE_CONST_JMP_OP(JmpIfNotLessEqualK, <=);
+
     do_Mov: {
         std::uint8_t  a               = decodeA(inst);
         std::uint16_t bx              = decodeBx(inst);
@@ -331,51 +930,19 @@ namespace Fig
         DISPATCH();
     }
 
-        BINARY_ARITHMETIC_OP(Add, +);
-        BINARY_ARITHMETIC_OP(Sub, -);
-        BINARY_ARITHMETIC_OP(Mul, *);
+        QUICKENING_ARITHMETIC_OP(Add, +);
+        QUICKENING_ARITHMETIC_OP(Sub, -);
+        QUICKENING_ARITHMETIC_OP(Mul, *);
         BINARY_ARITHMETIC_OP(Div, /);
+        BINARY_ARITHMETIC_OP(Mod, %);
 
-    do_Mod:
     do_BitXor:
-        assert(false && "VM: Mod and BitXor not fully implemented yet!");
+        assert(false && "VM: BitXor not fully implemented yet!");
         DISPATCH();
 
-    do_IntFastAdd: {
-        std::uint8_t a = decodeA(inst);
-        std::uint8_t b = decodeB(inst);
-        std::uint8_t c = decodeC(inst);
-
-        Value l = currentFrame->registerBase[b];
-        Value r = currentFrame->registerBase[c];
-
-        currentFrame->registerBase[a] = Value::FromInt(l.AsInt() + r.AsInt());
-        DISPATCH();
-    }
-
-    do_IntFastSub: {
-        std::uint8_t a = decodeA(inst);
-        std::uint8_t b = decodeB(inst);
-        std::uint8_t c = decodeC(inst);
-
-        Value l = currentFrame->registerBase[b];
-        Value r = currentFrame->registerBase[c];
-
-        currentFrame->registerBase[a] = Value::FromInt(l.AsInt() - r.AsInt());
-        DISPATCH();
-    }
-
-    do_IntFastMul: {
-        std::uint8_t a = decodeA(inst);
-        std::uint8_t b = decodeB(inst);
-        std::uint8_t c = decodeC(inst);
-
-        Value l = currentFrame->registerBase[b];
-        Value r = currentFrame->registerBase[c];
-
-        currentFrame->registerBase[a] = Value::FromInt(l.AsInt() * r.AsInt());
-        DISPATCH();
-    }
+        BINARY_ARITHMETIC_OP(IntFastAdd, +);
+        BINARY_ARITHMETIC_OP(IntFastSub, -);
+        BINARY_ARITHMETIC_OP(IntFastMul, *);
 
     do_IntFastDiv: {
         std::uint8_t a = decodeA(inst);
@@ -385,17 +952,65 @@ namespace Fig
         Value l = currentFrame->registerBase[b];
         Value r = currentFrame->registerBase[c];
 
-        currentFrame->registerBase[a] =
-            Value::FromDouble(static_cast<double>(l.AsInt()) / r.AsInt());
+        currentFrame->registerBase[a] = Value::FromDouble(numberToDouble(l) / numberToDouble(r));
         DISPATCH();
     }
 
+        INT_COMPARE_OP(IntFastEqual, ==);
+        INT_COMPARE_OP(IntFastNotEqual, !=);
+        INT_COMPARE_OP(IntFastGreater, >);
+        INT_COMPARE_OP(IntFastLess, <);
+        INT_COMPARE_OP(IntFastGreaterEqual, >=);
+        INT_COMPARE_OP(IntFastLessEqual, <=);
+
+        ARITHMETIC_IMM_OP(AddI, +);
+        ARITHMETIC_IMM_OP(SubI, -);
+        ARITHMETIC_IMM_OP(MulI, *);
+        ARITHMETIC_CONST_OP(AddK, +);
+        ARITHMETIC_CONST_OP(SubK, -);
+        ARITHMETIC_CONST_OP(MulK, *);
+
+        COMPARE_IMM_OP(EqualI, ==);
+        COMPARE_IMM_OP(NotEqualI, !=);
+        COMPARE_IMM_OP(GreaterI, >);
+        COMPARE_IMM_OP(LessI, <);
+        COMPARE_IMM_OP(GreaterEqualI, >=);
+        COMPARE_IMM_OP(LessEqualI, <=);
+
+        COMPARE_CONST_OP(EqualK, ==);
+        COMPARE_CONST_OP(NotEqualK, !=);
+        COMPARE_CONST_OP(GreaterK, >);
+        COMPARE_CONST_OP(LessK, <);
+        COMPARE_CONST_OP(GreaterEqualK, >=);
+        COMPARE_CONST_OP(LessEqualK, <=);
+
         BINARY_COMPARE_OP(Equal, ==);
         BINARY_COMPARE_OP(NotEqual, !=);
-        BINARY_COMPARE_OP(Greater, >);
-        BINARY_COMPARE_OP(Less, <);
-        BINARY_COMPARE_OP(GreaterEqual, >=);
-        BINARY_COMPARE_OP(LessEqual, <=);
+        QUICKENING_COMPARE_OP(Greater, >);
+        QUICKENING_COMPARE_OP(Less, <);
+        QUICKENING_COMPARE_OP(GreaterEqual, >=);
+        QUICKENING_COMPARE_OP(LessEqual, <=);
+
+        QUICK_ARITHMETIC_OP(AddInt, Add, IsInt, AsInt, intArithmetic, +);
+        QUICK_ARITHMETIC_OP(AddDouble, Add, IsDouble, AsDouble, doubleArithmetic, +);
+        QUICK_ARITHMETIC_OP(SubInt, Sub, IsInt, AsInt, intArithmetic, -);
+        QUICK_ARITHMETIC_OP(SubDouble, Sub, IsDouble, AsDouble, doubleArithmetic, -);
+        QUICK_ARITHMETIC_OP(MulInt, Mul, IsInt, AsInt, intArithmetic, *);
+        QUICK_ARITHMETIC_OP(MulDouble, Mul, IsDouble, AsDouble, doubleArithmetic, *);
+
+        QUICK_COMPARE_OP(GreaterInt, Greater, IsInt, AsInt, >);
+        QUICK_COMPARE_OP(GreaterDouble, Greater, IsDouble, AsDouble, >);
+        QUICK_COMPARE_OP(LessInt, Less, IsInt, AsInt, <);
+        QUICK_COMPARE_OP(LessDouble, Less, IsDouble, AsDouble, <);
+        QUICK_COMPARE_OP(GreaterEqualInt, GreaterEqual, IsInt, AsInt, >=);
+        QUICK_COMPARE_OP(GreaterEqualDouble, GreaterEqual, IsDouble, AsDouble, >=);
+        QUICK_COMPARE_OP(LessEqualInt, LessEqual, IsInt, AsInt, <=);
+        QUICK_COMPARE_OP(LessEqualDouble, LessEqual, IsDouble, AsDouble, <=);
+
+        QUICK_COMPARE_JMP_OP(JmpIfNotLessInt, JmpIfNotLess, IsInt, AsInt, <);
+        QUICK_COMPARE_JMP_OP(JmpIfNotLessDouble, JmpIfNotLess, IsDouble, AsDouble, <);
+        QUICK_COMPARE_JMP_OP(JmpIfNotLessEqualInt, JmpIfNotLessEqual, IsInt, AsInt, <=);
+        QUICK_COMPARE_JMP_OP(JmpIfNotLessEqualDouble, JmpIfNotLessEqual, IsDouble, AsDouble, <=);
 
     do_GetGlobal: {
         std::uint8_t  a               = decodeA(inst);
@@ -415,14 +1030,16 @@ namespace Fig
         std::uint8_t a = decodeA(inst);
         std::uint8_t b = decodeB(inst);
 
-        currentFrame->registerBase[a] = *(currentFrame->closure->upvalues[b]->location);
+        currentFrame->registerBase[a] = *(currentFrame->closure->upvalues[b].ref->location);
         DISPATCH();
     }
 
     do_SetUpval: {
-        std::uint8_t a                                  = decodeA(inst);
-        std::uint8_t b                                  = decodeB(inst);
-        *(currentFrame->closure->upvalues[b]->location) = currentFrame->registerBase[a]; // copy
+        std::uint8_t a  = decodeA(inst);
+        std::uint8_t b  = decodeB(inst);
+        Upvalue     *uv = currentFrame->closure->upvalues[b].ref;
+        *(uv->location) = currentFrame->registerBase[a]; // copy
+        upvalueBarrier(uv, currentFrame->registerBase[a]);
         DISPATCH();
     }
 
@@ -433,6 +1050,81 @@ namespace Fig
         DISPATCH();
     }
 
+    do_GetCapture: {
+        std::uint8_t a                = decodeA(inst);
+        std::uint8_t b                = decodeB(inst);
+        currentFrame->registerBase[a] = currentFrame->closure->upvalues[b].value;
+        DISPATCH();
+    }
+
+    do_GetField: {
+        std::uint8_t a = decodeA(inst);
+        std::uint8_t b = decodeB(inst);
+
+        Value recv = currentFrame->registerBase[b];
+        int   slot = staticFieldSlot(recv);
+        if (slot < 0) [[unlikely]]
+            return std::unexpected(staticFieldError(recv));
+        currentFrame->registerBase[a] = static_cast<InstanceObject *>(recv.AsObject())->fields[slot];
+        DISPATCH();
+    }
+
+    do_SetField: {
+        std::uint8_t a = decodeA(inst);
+        std::uint8_t c = decodeC(inst);
+
+        Value recv = currentFrame->registerBase[a];
+        int   slot = staticFieldSlot(recv);
+        if (slot < 0) [[unlikely]]
+            return std::unexpected(staticFieldError(recv));
+        auto *obj         = static_cast<InstanceObject *>(recv.AsObject());
+        obj->fields[slot] = currentFrame->registerBase[c];
+        writeBarrier(obj, obj->fields[slot]);
+        DISPATCH();
+    }
+
+    do_GetFieldK: {
+        std::uint8_t a = decodeA(inst);
+        std::uint8_t b = decodeB(inst);
+        std::uint8_t c = decodeC(inst);
+
+        Value recv = currentFrame->registerBase[b];
+        Value name = currentFrame->proto->constants[c];
+        int   slot = lookupFieldSite(recv, name);
+        if (slot < 0) [[unlikely]]
+            return std::unexpected(fieldNameError(recv, name));
+        currentFrame->registerBase[a] = static_cast<InstanceObject *>(recv.AsObject())->fields[slot];
+        DISPATCH();
+    }
+
+    do_SetFieldK: {
+        std::uint8_t a = decodeA(inst);
+        std::uint8_t b = decodeB(inst);
+        std::uint8_t c = decodeC(inst);
+
+        Value recv = currentFrame->registerBase[a];
+        Value name = currentFrame->proto->constants[b];
+        int   slot = lookupFieldSite(recv, name);
+        if (slot < 0) [[unlikely]]
+            return std::unexpected(fieldNameError(recv, name));
+        auto *obj         = static_cast<InstanceObject *>(recv.AsObject());
+        obj->fields[slot] = currentFrame->registerBase[c];
+        writeBarrier(obj, obj->fields[slot]);
+        DISPATCH();
+    }
+
+    do_NewInstance: {
+        std::uint8_t  a  = decodeA(inst);
+        std::uint16_t bx = decodeBx(inst);
+
+        auto *klass = static_cast<StructObject *>(currentFrame->proto->constants[bx].AsObject());
+        auto  res   = newInstance(klass, a);
+        if (!res) [[unlikely]]
+            return std::unexpected(res.error());
+        currentFrame->registerBase[a] = *res;
+        DISPATCH();
+    }
+
     do_Count: {
         assert(false && "Hit Count sentinel!");
         return Value::GetNullInstance();
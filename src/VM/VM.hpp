@@ -10,8 +10,26 @@
 #include <Compiler/Compiler.hpp>
 #include <Object/Object.hpp>
 #include <Core/Core.hpp>
+#include <VM/GCStats.hpp>
+#include <VM/Nursery.hpp>
+#include <VM/PageHeap.hpp>
+#if defined(__FCORE_GC_IMMIX)
+    #include <VM/ImmixHeap.hpp>
+#endif
+#include <VM/ParallelMarker.hpp>
+#include <VM/StringTable.hpp>
+#include <VM/VMConfig.hpp>
+#include <JIT/BaselineJit.hpp>
+#include <JIT/TraceJit.hpp>
+#include <Std/StdLib.hpp>
+#include <Utils/magic_enum/magic_enum.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <compare>
+#include <cstring>
 #include <iostream> // debug
 #include <print>
 
@@ -38,32 +56,69 @@ namespace Fig
         Sweeping
     };
 
+    // 老年代分配器在构建时选择 (xmake f --gc-immix=y)
+#if defined(__FCORE_GC_IMMIX)
+    using OldHeap = ImmixHeap;
+#else
+    using OldHeap = PageHeap;
+#endif
+
     class VM
     {
     private:
-        static constexpr unsigned int MAX_REGISTERS       = 1024;
-        static constexpr unsigned int MAX_GLOBALS         = 65536;
-        static constexpr unsigned int MAX_RECURSION_DEPTH = 2233;
-
-        Instruction POISON_MAX_RECURSION_DEPTH_EXCEED_INST;
+        VMConfig config;
 
-        // 一次性分配
-        Value registers[MAX_REGISTERS];
-        Value globals[MAX_GLOBALS];
+        // 按 CompiledModule::globalCount 分配，Repl 中只增不减
+        DynArray<Value> globals;
 
-        CallFrame  frames[MAX_RECURSION_DEPTH];
-        CallFrame *currentFrame;
-        CallFrame *frameLimit;
+        // 寄存器栈与调用栈按需倍增 (搬迁式)，搬迁后修正帧基址与 open upvalue
+        DynArray<Value>     stack;
+        DynArray<CallFrame> frames; // frames[0] 为哨兵帧
+        CallFrame          *currentFrame;
 
         Upvalue *openUpvalues = nullptr;
 
+        // 分配了调用点内联缓存的 Proto；缓存中的闭包是弱引用，每次回收后清理
+        DynArray<Proto *> callSiteProtos;
+
+        Jit::BaselineJit jit;
+        Jit::TraceJit    traceJit;
+
+#if defined(__FCORE_QUICKEN_STATS)
+        // 调试构建：按特化指令统计改写 / 退回次数
+        std::array<std::uint64_t, static_cast<std::size_t>(OpCode::Count)> quickenCount{};
+        std::array<std::uint64_t, static_cast<std::size_t>(OpCode::Count)> dequickenCount{};
+#endif
+
         // GC
-        Object            *objects = nullptr; // 链表头
+        // 老年代：按大小分级的页 (或 Immix 块)，由增量标记-清除回收，惰性清扫
+        OldHeap            heap;
         DynArray<Object *> grayStack;
+        DynArray<Object *> youngGrayStack; // 新生代中的灰色对象，Minor GC 晋升后并入 grayStack
+        ParallelMarker     marker; // --gc-threads > 1 时使用
+
+        // 新生代：指针碰撞分配，Minor GC 把存活对象晋升到老年代
+        Nursery            nursery;
+        DynArray<Object *> promotedQueue; // Minor GC 中待扫描的新晋升对象
+
+        // 记忆集：持有新生代引用的老年代对象 / 已关闭的 Upvalue，作为 Minor GC 的额外根
+        DynArray<Object *>  rememberedObjects;
+        DynArray<Upvalue *> rememberedUpvalues;
+
+        // 字符串驻留表 (弱引用)；youngStrings 是驻留在新生代里的，Minor GC 后据此修正表项
+        StringTable              strings;
+        DynArray<StringObject *> youngStrings;
 
-        size_t  allocatedBytes = 0;
-        size_t  nextGC         = 1024 * 1024; // byte, 1MB初始阈值
-        GCPhase gcPhase        = GCPhase::Idle;
+        // 老年代字节数即 heap.UsedBytes()：分配时增加，清扫回收格子时减少
+        size_t  nextGC  = 1024 * 1024; // byte, 1MB初始阈值
+        size_t  gcDebt  = 0;           // 本轮开始后尚未偿还的分配字节
+        GCPhase gcPhase = GCPhase::Idle;
+
+        // 统计始终收集 (只是计数与取时钟)；--gc-trace 时每轮结束打印与上一轮起点的差
+        GCStats       gcStats;
+        GCStats       cycleStartStats;
+        std::uint64_t cycleMaxPauseNanos = 0;
+        std::uint64_t nurseryFreedBytes  = 0;
 
     private:
         inline void closeUpvalues(Value *level)
@@ -75,45 +130,135 @@ namespace Fig
                 upval->closedValue = *upval->location;
                 upval->location    = &upval->closedValue;
                 openUpvalues       = upval->next;
+
+                if (upval->refCount == 0)
+                {
+                    // 捕获它的闭包都已回收，只是还挂在 open 链表上
+                    delete upval;
+                    continue;
+                }
+                upvalueBarrier(upval, upval->closedValue);
             }
         }
 
+        // 对象实际占用字节 (Header + 柔性数组)
+        static size_t objectSize(const Object *obj)
+        {
+            switch (obj->type)
+            {
+                case ObjectType::String: return sizeof(StringObject);
+                case ObjectType::Instance:
+                    return sizeof(InstanceObject)
+                           + (obj->klass ? obj->klass->fieldCount * sizeof(Value) : 0);
+                case ObjectType::Function:
+                    return sizeof(FunctionObject)
+                           + static_cast<const FunctionObject *>(obj)->upvalueCount * sizeof(UpvalueSlot);
+                case ObjectType::Struct: return sizeof(StructObject);
+                case ObjectType::NativeFunction: return sizeof(NativeFunctionObject);
+                case ObjectType::BigInt:
+                    return sizeof(BigIntObject)
+                           + static_cast<const BigIntObject *>(obj)->size * sizeof(BigInt::Limb);
+            }
+            return sizeof(Object);
+        }
+
+        [[nodiscard]] inline bool isYoung(const Object *obj) const
+        {
+            return nursery.Contains(obj);
+        }
+
+        // 超过该大小的对象直接进老年代，避免大对象在 Minor GC 中反复拷贝
+        size_t maxNurseryObjectSize() const
+        {
+            return nursery.Capacity() / 16;
+        }
+
+        /*
+            分配一个对象。超出 heapLimitBytes 或系统内存耗尽时先做一次完整的同步回收，
+            仍然放不下返回 nullptr，由调用方报 OutOfMemory (outOfMemoryError)
+        */
         template <typename T>
         [[nodiscard]] T *allocateObject(ObjectType type, size_t extraBytes)
         {
 
-            if (allocatedBytes > nextGC) // 超出阈值
+            size_t totalSize = sizeof(T) + extraBytes;
+
+            if (gcPhase == GCPhase::Idle)
             {
-                switch (gcPhase)
+                // 老年代超出阈值开始一轮
+                if (heap.UsedBytes() > nextGC) [[unlikely]]
                 {
-                    case GCPhase::Idle: markRoots(); break;
-                    case GCPhase::Marking: stepMarking(); break;
-                    case GCPhase::Sweeping: sweep(); break;
+                    auto begin = Time::Clock::now();
+                    beginCycleStats();
+                    markRoots();
+                    if (marker.ThreadCount() > 1)
+                    {
+                        collectParallel();
+                        recordPause(GCPause::Parallel, begin);
+                    }
+                    else
+                    {
+                        recordPause(GCPause::MarkStart, begin);
+                    }
                 }
             }
+            else
+            {
+                // 一轮进行中：分配累积债务，每欠下 gcStepBytes 还一步
+                gcDebt += totalSize;
+                if (gcDebt >= config.gcStepBytes) [[unlikely]]
+                    gcStep();
+            }
 
-            size_t totalSize = sizeof(T) + extraBytes;
-
-            // 物理分配
-            T *obj = static_cast<T *>(std::malloc(totalSize));
-            if (!obj) [[unlikely]]
+            T *obj = nullptr;
+            if (totalSize <= maxNurseryObjectSize()) [[likely]]
             {
-                // 分配失败
-                CoreIO::GetStdErr() << "Oops! Object allocating failed! Exiting...\n";
-                std::exit(1);
+                void *mem = nursery.Allocate(totalSize);
+                if (!mem) [[unlikely]]
+                {
+                    // 最坏情况下整个新生代都晋升
+                    if (overHeapLimit(nursery.Used())) [[unlikely]]
+                    {
+                        collectFull(); // 其中的 Minor GC 已清空新生代
+                        if (overHeapLimit(0))
+                            return nullptr;
+                    }
+                    else
+                    {
+                        minorCollect();
+                    }
+                    mem = nursery.Allocate(totalSize);
+                }
+                obj = static_cast<T *>(mem);
+            }
+            else
+            {
+                obj = static_cast<T *>(allocateLarge(totalSize));
+                if (!obj) [[unlikely]]
+                    return nullptr;
             }
+            obj->next = nullptr; // 新生代中 next 用作晋升后的转发指针
+
+            gcStats.bytesAllocated += totalSize;
+            gcStats.objectsAllocated++;
 
             // 构造 Header
+            // 标记进行中分配的对象直接为黑色；其余为白色，等下一轮从根出发发现
+            // (清扫期只从已清扫的页分配，白色新对象不会被本轮回收)
             obj->type  = type;
-            obj->color = GCColor::Black;
+            obj->color = (gcPhase == GCPhase::Marking) ? GCColor::Black : GCColor::White;
+            if (!isYoung(obj))
+                adoptColor(obj);
             obj->klass = nullptr;
-            obj->next  = objects; // 插入全局追踪链表
-            objects    = obj;
-
-            allocatedBytes += totalSize;
+            obj->remembered = false;
             return obj;
         }
 
+        /*
+            写屏障：每次把引用写进堆对象后调用
+                增量标记：黑色对象不能指向白色对象
+                分代：老年代对象指向新生代时记入记忆集
+        */
         inline void writeBarrier(Object *parent, Value childVal)
         {
             if (!childVal.IsObject())
@@ -121,231 +266,1273 @@ namespace Fig
 
             Object *child = childVal.AsObject();
             // 三色不变式, 黑色对象绝对不能指向白色对象
-            if (parent->color == GCColor::Black && child->color == GCColor::White)
+            if (gcPhase == GCPhase::Marking && isBlack(parent))
+                markValue(childVal);
+
+            if (!parent->remembered && isYoung(child) && !isYoung(parent))
             {
-                child->color = GCColor::Gray;
-                grayStack.push_back(child);
+                parent->remembered = true;
+                rememberedObjects.push_back(parent);
             }
         }
 
+        /*
+            Upvalue 屏障：SetUpval 与 closeUpvalues 之后调用
+                增量标记：持有它的闭包可能已是黑色，新值直接着色
+                分代：已关闭的 Upvalue 不属于任何对象，持有新生代引用时单独记入记忆集
+        */
+        inline void upvalueBarrier(Upvalue *uv, Value value)
+        {
+            if (!value.IsObject())
+                return;
+            if (gcPhase == GCPhase::Marking)
+                markValue(value);
+
+            if (uv->remembered || uv->location != &uv->closedValue || !isYoung(value.AsObject()))
+                return;
+            uv->remembered = true;
+            rememberedUpvalues.push_back(uv);
+        }
+
+        /*
+            着色：PageHeap 下一律看对象头的 color。
+            Immix 下老年代对象的 color 恒为 White，标记记在块内标记位里；新生代与常驻对象
+            (常量池字符串、原生函数，恒为 Black) 仍用 color
+        */
+        inline bool shade(Object *obj)
+        {
+            if (obj->color != GCColor::White)
+                return false;
+#if defined(__FCORE_GC_IMMIX)
+            if (!isYoung(obj))
+                return ImmixHeap::TryMark(obj);
+#endif
+            obj->color = GCColor::Gray;
+            return true;
+        }
+
+        inline void blacken(Object *obj)
+        {
+#if defined(__FCORE_GC_IMMIX)
+            if (!isYoung(obj))
+                return;
+#endif
+            obj->color = GCColor::Black;
+        }
+
+        // Immix 下老年代对象灰色也算已标记，屏障多着色几个对象无妨
+        inline bool isBlack(const Object *obj) const
+        {
+#if defined(__FCORE_GC_IMMIX)
+            if (!isYoung(obj))
+                return ImmixHeap::IsMarked(obj);
+#endif
+            return obj->color == GCColor::Black;
+        }
+
+        // 对象进入老年代 (直接分配或晋升)：Immix 下把颜色转成块内标记位
+        inline void adoptColor(Object *old)
+        {
+#if defined(__FCORE_GC_IMMIX)
+            if (old->color != GCColor::White)
+            {
+                ImmixHeap::SetMarked(old);
+                old->color = GCColor::White;
+            }
+#else
+            (void) old;
+#endif
+        }
+
         inline void markValue(Value value)
         {
             if (!value.IsObject())
                 return;
 
             Object *obj = value.AsObject();
-            if (obj && obj->color == GCColor::White)
+            if (obj && shade(obj))
             {
-                obj->color = GCColor::Gray;
-                grayStack.push_back(obj);
+                // 新生代灰对象分开放，Minor GC 只需修正这一小段而不是整个灰栈
+                (isYoung(obj) ? youngGrayStack : grayStack).push_back(obj);
             }
         }
 
-        void markRoots()
+        Object *popGray()
         {
-            // 扫描全局变量
-            for (std::uint32_t i = 0; i < MAX_GLOBALS; ++i)
+            DynArray<Object *> &stack = youngGrayStack.empty() ? grayStack : youngGrayStack;
+            Object             *obj   = stack.back();
+            stack.pop_back();
+            return obj;
+        }
+
+        // 访问对象持有的每个引用槽位，visit 可以改写槽位 (Minor GC 更新为晋升后的地址)
+        template <typename F>
+        static void forEachReference(Object *obj, F &&visit)
+        {
+            switch (obj->type)
             {
-                markValue(globals[i]);
+                case ObjectType::Function: {
+                    auto *fn = static_cast<FunctionObject *>(obj);
+                    for (std::uint32_t i = 0; i < fn->upvalueCount; ++i)
+                    {
+                        if (fn->CapturedByValue(i))
+                            visit(fn->upvalues[i].value);
+                        else if (fn->upvalues[i].ref)
+                            visit(*(fn->upvalues[i].ref->location));
+                    }
+                    break;
+                }
+                case ObjectType::Instance: {
+                    auto *inst = static_cast<InstanceObject *>(obj);
+                    if (inst->klass)
+                    {
+                        Value klass = Value::FromObject(inst->klass);
+                        visit(klass);
+                        inst->klass = static_cast<StructObject *>(klass.AsObject());
+                    }
+                    // 扫描所有实例字段
+                    std::uint8_t fieldCount = inst->klass ? inst->klass->fieldCount : 0;
+                    for (std::uint8_t i = 0; i < fieldCount; ++i)
+                    {
+                        visit(inst->fields[i]);
+                    }
+                    break;
+                }
+                case ObjectType::Struct: {
+                    auto *st = static_cast<StructObject *>(obj);
+                    for (int i = 0; i < GetOperatorsSize(); ++i)
+                    {
+                        if (st->operators[i])
+                        {
+                            Value op = Value::FromObject(st->operators[i]);
+                            visit(op);
+                            st->operators[i] = op.AsObject();
+                        }
+                    }
+                    break;
+                }
+                case ObjectType::String:
+                case ObjectType::NativeFunction:
+                case ObjectType::BigInt: break; // 叶子节点
             }
+        }
 
-            // 扫描vm全部栈 [registers[0], currentFrame]
-            if (currentFrame && currentFrame->proto)
+        // 释放对象持有的 C++ 堆资源与 Upvalue 引用 (不释放对象本身的内存)
+        static void finalizeObject(Object *obj)
+        {
+            // 函数 upvalue需要手动析构
+            if (obj->type == ObjectType::Function)
             {
-                Value *stackTop = currentFrame->registerBase + currentFrame->proto->maxRegisters;
-                for (Value *slot = registers; slot < stackTop; ++slot)
+                auto *fn = static_cast<FunctionObject *>(obj);
+                fn->name.~String();
+                for (std::uint32_t i = 0; i < fn->upvalueCount; ++i)
                 {
-                    markValue(*slot);
+                    if (fn->CapturedByValue(i))
+                        continue;
+                    Upvalue *uv = fn->upvalues[i].ref;
+                    if (uv)
+                    {
+                        uv->refCount--; // 减引用
+                        // 只有当所有闭包都死后才释放；仍 open 的由 closeUpvalues 释放
+                        if (uv->refCount == 0 && uv->location == &uv->closedValue)
+                        {
+                            delete uv;
+                        }
+                    }
                 }
             }
 
-            // 扫描逃逸链表 (Open Upvalues)
-            for (Upvalue *uv = openUpvalues; uv != nullptr; uv = uv->next)
+            // 持有 C++ 堆资源的成员手动析构!
+            else if (obj->type == ObjectType::String)
             {
-                markValue(uv->closedValue);
+                static_cast<StringObject *>(obj)->data.~String();
             }
+        }
 
-            gcPhase = GCPhase::Marking;
+        Value *stackTop()
+        {
+            return currentFrame->proto ? currentFrame->registerBase + currentFrame->proto->maxRegisters
+                                       : currentFrame->registerBase;
         }
 
-        void stepMarking()
+        // 栈顶以上的槽位是已返回帧留下的旧值，清空以免之后被当作根扫描到悬空指针
+        void clearDeadStack()
         {
-            // 每次步进处理的对象数量
-            constexpr int WORK_LIMIT = 64;
-            int           workCount  = 0;
+            std::fill(stackTop(), stack.data() + stack.size(), Value::GetNullInstance());
+        }
 
-            while (!grayStack.empty() && workCount++ < WORK_LIMIT)
+        /*
+            按各帧安全点的活跃位图遍历寄存器栈：live(Value&) 只处理之后还会被读取的槽位，
+            死槽位直接清空，这样它引用的对象被回收后也不会留下悬空指针。
+            帧从栈顶往下走，调用方只拥有被调方 registerBase 以下的部分 (参数窗口归被调方)。
+            挂起的帧停在调用指令上，栈顶帧停在分配指令上，都是安全点；
+            万一 pc 没有位图 (不该发生)，保守地整帧扫描
+        */
+        template <typename F>
+        void forEachStackRoot(F &&live)
+        {
+            Value *limit = stackTop();
+            for (CallFrame *f = currentFrame; f > frames.data(); --f)
             {
-                Object *obj = grayStack.back();
-                grayStack.pop_back();
+                Proto *proto = f->proto;
+                Value *base  = f->registerBase;
+                Value *end   = std::min(base + proto->maxRegisters, limit);
 
-                // 标记为黑色：表示该对象及其子引用已处理完毕
-                obj->color = GCColor::Black;
+                auto pc = static_cast<std::uint32_t>(f->ip - proto->code.data()) - 1;
+                const std::uint64_t *bits = proto->LiveMapAt(pc);
 
-                switch (obj->type)
+                for (Value *slot = base; slot < end; ++slot)
                 {
-                    case ObjectType::Function: {
-                        auto *fn = static_cast<FunctionObject *>(obj);
-                        for (std::uint32_t i = 0; i < fn->upvalueCount; ++i)
-                        {
-                            if (fn->upvalues[i])
-                                markValue(*(fn->upvalues[i]->location));
-                        }
-                        break;
-                    }
-                    case ObjectType::Instance: {
-                        auto *inst = static_cast<InstanceObject *>(obj);
-                        if (inst->klass)
-                            markValue(Value::FromObject(inst->klass));
-                        // 扫描所有实例字段
-                        std::uint8_t fieldCount = inst->klass ? inst->klass->fieldCount : 0;
-                        for (std::uint8_t i = 0; i < fieldCount; ++i)
-                        {
-                            markValue(inst->fields[i]);
-                        }
-                        break;
-                    }
-                    case ObjectType::Struct: {
-                        auto *st = static_cast<StructObject *>(obj);
-                        for (int i = 0; i < GetOperatorsSize(); ++i)
-                        {
-                            if (st->operators[i])
-                                markValue(Value::FromObject(st->operators[i]));
-                        }
-                        break;
-                    }
-                    case ObjectType::String: break; // 叶子节点
+                    std::size_t r = static_cast<std::size_t>(slot - base);
+                    if (!bits || (bits[r / 64] >> (r % 64)) & 1)
+                        live(*slot);
+                    else
+                        *slot = Value::GetNullInstance();
+                }
+                limit = std::min(limit, base);
+            }
+        }
+
+        // 老年代再增长 grow 字节是否会越过 --heap-limit
+        [[nodiscard]] inline bool overHeapLimit(size_t grow) const
+        {
+            return config.heapLimitBytes != 0 && heap.UsedBytes() + grow > config.heapLimitBytes;
+        }
+
+        // 大对象直接进老年代，放不下时回收一次再试
+        void *allocateLarge(size_t size)
+        {
+            if (overHeapLimit(size))
+            {
+                collectFull();
+                if (overHeapLimit(size))
+                    return nullptr;
+            }
+            void *mem = heap.Allocate(size);
+            if (!mem) [[unlikely]]
+            {
+                collectFull();
+                mem = heap.Allocate(size);
+            }
+            return mem;
+        }
+
+        // 晋升的老年代分配：Minor GC 拷贝到一半无法回退，系统内存耗尽只能退出
+        void *allocateOld(size_t size)
+        {
+            void *mem = heap.Allocate(size);
+            if (!mem) [[unlikely]]
+            {
+                CoreIO::GetStdErr() << "Oops! Object promotion failed: out of system memory. Exiting...\n";
+                std::exit(1);
+            }
+            return mem;
+        }
+
+        /*
+            晋升：新生代对象按位拷贝到老年代 (String 成员只含指向堆的指针，可按位搬迁)，
+            原位置的 next 记下新地址，之后对同一对象的引用直接转发
+        */
+        Object *promote(Object *young)
+        {
+            if (young->next)
+                return young->next;
+
+            size_t size = objectSize(young);
+            auto  *old  = static_cast<Object *>(allocateOld(size));
+            std::memcpy(static_cast<void *>(old), young, size);
+
+            old->next   = nullptr;
+            young->next = old;
+            adoptColor(old);
+
+            promotedQueue.push_back(old);
+            gcStats.bytesPromoted += size;
+            gcStats.objectsPromoted++;
+            return old;
+        }
+
+        inline void forward(Value &slot)
+        {
+            if (slot.IsObject() && isYoung(slot.AsObject()))
+                slot = Value::FromObject(promote(slot.AsObject()));
+        }
+
+        /*
+            移动对象的回收 (Minor GC 晋升、Immix 疏散) 共用：活跃寄存器、全局变量、
+            帧闭包中的对象指针换成 relocate 的结果 (调用点缓存是弱引用，由 pruneCallCaches 处理)
+        */
+        template <typename F>
+        void relocateRoots(F &&relocate)
+        {
+            forEachStackRoot([&](Value &v) {
+                if (v.IsObject())
+                    v = Value::FromObject(relocate(v.AsObject()));
+            });
+            for (Value &v : globals)
+            {
+                if (v.IsObject())
+                    v = Value::FromObject(relocate(v.AsObject()));
+            }
+
+            for (CallFrame *f = frames.data(); f <= currentFrame; ++f)
+            {
+                if (f->closure)
+                    f->closure = static_cast<FunctionObject *>(relocate(f->closure));
+            }
+        }
+
+        /*
+            Minor GC：从根和记忆集出发，把可达的新生代对象全部晋升 (Cheney 式广度扫描)，
+            再线性遍历新生代析构死对象，最后整体重置。
+            标记进行中也可以执行：晋升保留颜色，新生代灰对象晋升后并入 grayStack
+        */
+        void minorCollect()
+        {
+            if (nursery.Used() == 0)
+                return;
+
+            auto begin = Time::Clock::now();
+            clearDeadStack();
+
+            relocateRoots([this](Object *obj) { return isYoung(obj) ? promote(obj) : obj; });
+
+            for (Object *gray : youngGrayStack)
+                grayStack.push_back(promote(gray));
+            youngGrayStack.clear();
+
+            for (Object *obj : rememberedObjects)
+            {
+                obj->remembered = false;
+                forEachReference(obj, [this](Value &v) { forward(v); });
+            }
+            rememberedObjects.clear();
+
+            for (Upvalue *uv : rememberedUpvalues)
+            {
+                uv->remembered = false;
+                forward(uv->closedValue);
+            }
+            rememberedUpvalues.clear();
+
+            while (!promotedQueue.empty())
+            {
+                Object *obj = promotedQueue.back();
+                promotedQueue.pop_back();
+                forEachReference(obj, [this](Value &v) { forward(v); });
+            }
+
+            // 驻留表不持有字符串：晋升的换成新地址，死去的删掉 (对象在 Reset 前仍可读 hash)
+            for (StringObject *str : youngStrings)
+            {
+                if (str->next)
+                    strings.Replace(str, static_cast<StringObject *>(str->next));
+                else
+                    strings.Remove(str);
+            }
+            youngStrings.clear();
+
+            // 调用点缓存同理：晋升的闭包换成新地址，死去的清空
+            pruneCallCaches([this](FunctionObject *fn) -> FunctionObject * {
+                if (!isYoung(fn))
+                    return fn;
+                return static_cast<FunctionObject *>(fn->next);
+            });
+
+            // 线性遍历：没有转发地址的就是死对象，只需释放其 C++ 资源
+            for (std::byte *p = nursery.Begin(); p < nursery.Top();)
+            {
+                auto  *obj  = reinterpret_cast<Object *>(p);
+                size_t size = Nursery::AlignSize(objectSize(obj));
+                if (!obj->next)
+                {
+                    finalizeObject(obj);
+                    nurseryFreedBytes += size;
                 }
+                p += size;
             }
+            nursery.Reset();
 
-            if (grayStack.empty())
-                gcPhase = GCPhase::Sweeping;
+            gcStats.minorCollections++;
+            recordPause(GCPause::Minor, begin);
         }
 
-        void sweep()
+        // 根集合：全局变量、活动寄存器、调用帧闭包、open upvalue (调用点缓存不算根)
+        void scanRoots()
         {
-            Object **curr      = &objects;
-            size_t   liveBytes = 0;
+            // 扫描全局变量
+            for (const Value &v : globals)
+            {
+                markValue(v);
+            }
 
-            while (*curr != nullptr)
+            // 各帧的活跃寄存器
+            forEachStackRoot([this](Value &v) { markValue(v); });
+
+            // 帧里的闭包不一定还留在某个寄存器中
+            for (CallFrame *f = frames.data(); f <= currentFrame; ++f)
             {
-                Object *obj = *curr;
-                if (obj->color == GCColor::White)
+                if (f->closure)
+                    markValue(Value::FromObject(f->closure));
+            }
+
+            // 扫描逃逸链表 (Open Upvalues)：值仍在栈上，closedValue 尚未使用
+            for (Upvalue *uv = openUpvalues; uv != nullptr; uv = uv->next)
+            {
+                markValue(*uv->location);
+            }
+        }
+
+        void markRoots()
+        {
+            clearDeadStack();
+            scanRoots();
+            gcDebt  = 0;
+            gcPhase = GCPhase::Marking;
+        }
+
+        /*
+            增量标记，处理灰色对象直到工作量达到 goal 或超过 deadline。
+            寄存器与全局变量的写入没有屏障 (JIT 代码同样直接写)，所以灰栈排空时重新扫描一遍根：
+            没有新的灰色对象才算标记完成，转入清扫
+        */
+        void stepMarking(Time::Clock::time_point deadline, size_t goal, size_t &work)
+        {
+            // 每处理这么多对象看一次时钟
+            constexpr int CLOCK_INTERVAL = 64;
+            int           workCount      = 0;
+
+            while (true)
+            {
+                while (!grayStack.empty() || !youngGrayStack.empty())
                 {
-                    *curr = obj->next;
+                    Object *obj = popGray();
 
-                    // 函数 upvalue需要手动析构
-                    if (obj->type == ObjectType::Function)
-                    {
-                        auto *fn = static_cast<FunctionObject *>(obj);
-                        fn->name.~String();
-                        for (std::uint32_t i = 0; i < fn->upvalueCount; ++i)
-                        {
-                            Upvalue *uv = fn->upvalues[i];
-                            if (uv)
-                            {
-                                uv->refCount--; // 减引用
-                                if (uv->refCount == 0)
-                                {
-                                    // 只有当所有闭包都死后，才 free 这个 Upvalue 结构体
-                                    
-                                    std::free(uv);
-                                }
-                            }
-                        }
-                    }
+                    // 标记为黑色：表示该对象及其子引用已处理完毕
+                    blacken(obj);
+                    forEachReference(obj, [this](Value &v) { markValue(v); });
+                    work += objectSize(obj);
 
-                    // 持有 C++ 堆资源的成员手动析构!
-                    else if (obj->type == ObjectType::String)
+                    if (++workCount == CLOCK_INTERVAL)
                     {
-                        static_cast<StringObject *>(obj)->data.~String();
+                        workCount = 0;
+                        if (work >= goal || Time::Clock::now() >= deadline)
+                            return;
                     }
+                }
 
-                    std::free(obj);
+                scanRoots();
+                if (grayStack.empty() && youngGrayStack.empty())
+                {
+                    beginSweep();
+                    return;
                 }
+            }
+        }
+
+        /*
+            每欠 1 字节做 GCPaceRatio 字节的回收工作 (标记按对象大小、清扫按页大小计)，
+            一步至多 gcStepMicros 微秒。超时没还清的债务留着，下一次分配立刻再走一步，
+            回收跟不上分配时由 mutator 让出时间，而不是让堆无限增长
+        */
+        static constexpr size_t GCPaceRatio = 2;
+
+        void gcStep()
+        {
+            auto    begin    = Time::Clock::now();
+            auto    deadline = begin + std::chrono::microseconds(config.gcStepMicros);
+            GCPause kind     = gcPhase == GCPhase::Marking ? GCPause::Mark : GCPause::Sweep;
+            size_t  goal     = gcDebt * GCPaceRatio;
+            size_t  work     = 0;
+
+            while (gcPhase != GCPhase::Idle && work < goal && Time::Clock::now() < deadline)
+            {
+                if (gcPhase == GCPhase::Marking)
+                    stepMarking(deadline, goal, work);
                 else
-                {
-                    // 洗白，仍是一条好汉
-                    // 以备下次 GC，统计存活大小
-                    obj->color = GCColor::White;
+                    stepSweeping(deadline, goal, work);
+            }
 
-                    // 计算存活对象的真实物理大小 (Header + 柔性数组/额外数据)
-                    size_t objectSize = 0;
-                    switch (obj->type)
-                    {
-                        case ObjectType::String: objectSize = sizeof(StringObject); break;
-                        case ObjectType::Instance:
-                            objectSize =
-                                sizeof(InstanceObject)
-                                + (obj->klass ? obj->klass->fieldCount * sizeof(Value) : 0);
-                            break;
-                        case ObjectType::Function:
-                            objectSize = sizeof(FunctionObject)
-                                         + (static_cast<FunctionObject *>(obj)->upvalueCount
-                                             * sizeof(Upvalue *));
-                            break;
-                        case ObjectType::Struct: objectSize = sizeof(StructObject); break;
-                    }
+            size_t paid = work / GCPaceRatio;
+            gcDebt      = (gcPhase == GCPhase::Idle || paid >= gcDebt) ? 0 : gcDebt - paid;
+
+            recordPause(kind, begin);
+            if (gcPhase == GCPhase::Idle && config.gcTrace)
+                traceCycle();
+        }
+
+        /*
+            并行模式：根已压入 grayStack，多线程一次排空后立即清扫，整轮回收在同一次停顿内完成。
+            不与 mutator 交错，因此不依赖写屏障维持三色不变式
+        */
+        void collectParallel()
+        {
+            grayStack.insert(grayStack.end(), youngGrayStack.begin(), youngGrayStack.end());
+            youngGrayStack.clear();
+            auto scan = [](Object *obj, auto &visit) { forEachReference(obj, visit); };
+#if defined(__FCORE_GC_IMMIX)
+            marker.Drain(grayStack, scan, ParallelMarks{&nursery});
+#else
+            marker.Drain(grayStack, scan);
+#endif
+            beginSweep();
+        }
+
+        // 把进行中的一轮不限时地做完
+        void finishCycle()
+        {
+            auto   never = Time::Clock::time_point::max();
+            size_t work  = 0;
+            while (gcPhase == GCPhase::Marking)
+                stepMarking(never, SIZE_MAX, work);
+            while (gcPhase == GCPhase::Sweeping)
+                stepSweeping(never, SIZE_MAX, work);
+            gcDebt = 0;
+        }
+
+        /*
+            完整的同步回收，触及堆上限时使用。进行中的一轮从旧的根出发，之后才死去的对象
+            它回收不了，所以先把它做完，再从当前的根完整地走一轮
+        */
+        void collectFull()
+        {
+            auto begin = Time::Clock::now();
+            if (gcPhase != GCPhase::Idle)
+            {
+                finishCycle();
+                if (config.gcTrace)
+                    traceCycle();
+            }
 
-                    liveBytes += objectSize;
+            beginCycleStats();
+            markRoots();
+            if (marker.ThreadCount() > 1)
+                collectParallel();
+            finishCycle();
+
+            recordPause(GCPause::Full, begin);
+            if (config.gcTrace)
+                traceCycle();
+        }
+
+        /*
+            惰性清扫：标记结束时只把页转为待清扫，之后每个 GC 步按时间预算一页一页清扫，
+            分配到没有空闲格子的级别时再就地清扫该级别，单次分配不再承担整堆清扫
+        */
+        void beginSweep()
+        {
+            // 先清空新生代：存活对象带着标记颜色进入老年代，随本轮一起清扫，记忆集随之清空
+            minorCollect();
+#if defined(__FCORE_GC_IMMIX)
+            evacuate();
+#endif
+            pruneStrings();
+            pruneCallCaches([this](FunctionObject *fn) -> FunctionObject * {
+#if defined(__FCORE_GC_IMMIX)
+                if (fn->next)
+                    fn = static_cast<FunctionObject *>(fn->next); // 被疏散
+#endif
+                return isBlack(fn) ? fn : nullptr;
+            });
+            heap.BeginSweep();
+            gcPhase = GCPhase::Sweeping;
+        }
+
+        // 标记已完整、新生代已清空：删掉未标记的驻留字符串，它们即将被清扫
+        void pruneStrings()
+        {
+            strings.Prune([this](StringObject *&str) {
+#if defined(__FCORE_GC_IMMIX)
+                if (str->next)
+                    str = static_cast<StringObject *>(str->next); // 被疏散
+#endif
+                // 常量池字符串恒为 Black，不在老年代里
+                return str->color == GCColor::Black || isBlack(str);
+            });
+        }
 
-                    curr = &obj->next;
+        /*
+            调用点缓存是弱引用：只见过一次的短命闭包不应被缓存一直留着，连同它捕获的对象。
+            survivor 返回闭包的新地址，死去时返回 nullptr，对应条目重置为未命中
+        */
+        template <typename F>
+        void pruneCallCaches(F &&survivor)
+        {
+            for (Proto *proto : callSiteProtos)
+            {
+                for (CallSiteCache &ic : proto->callCache)
+                {
+                    if (!ic.callee)
+                        continue;
+                    if (FunctionObject *fn = survivor(ic.callee))
+                    {
+                        ic.callee     = fn;
+                        ic.calleeBits = Value::FromObject(fn).Raw();
+                    }
+                    else
+                    {
+                        ic = CallSiteCache{};
+                    }
                 }
             }
+        }
 
-            allocatedBytes = liveBytes;
+        void stepSweeping(Time::Clock::time_point deadline, size_t goal, size_t &work)
+        {
+            while (!heap.SweepStep(1))
+            {
+                work += OldHeap::SweepUnit;
+                if (work >= goal || Time::Clock::now() >= deadline)
+                    return;
+            }
+
+            // 清扫完：UsedBytes 只剩存活对象与清扫期间的新分配
             // 阈值调整, 当下一次分配超过存活内存的 2 倍时触发 GC
-            nextGC = (liveBytes < 512 * 1024) ? 1024 * 1024 : liveBytes * 2;
+            size_t liveBytes = heap.UsedBytes();
+            nextGC           = (liveBytes < 512 * 1024) ? 1024 * 1024 : liveBytes * 2;
 
             gcPhase = GCPhase::Idle;
         }
 
-    public:
-        VM()
+#if defined(__FCORE_GC_IMMIX)
+        // 并行标记的着色，与 shade / blacken 一致
+        struct ParallelMarks
         {
-            for (unsigned int i = 0; i < MAX_REGISTERS; ++i)
+            const Nursery *nursery;
+
+            bool TryMark(Object *obj) const
             {
-                registers[i] = Value::GetNullInstance();
+                if (nursery->Contains(obj))
+                    return ColorMarks::TryMark(obj);
+                // 老年代对象与常驻对象的 color 在标记期间不会被改写
+                return obj->color == GCColor::White && ImmixHeap::TryMarkAtomic(obj);
             }
-            for (unsigned int i = 0; i < MAX_GLOBALS; ++i)
+
+            void Blacken(Object *obj) const
             {
-                globals[i] = Value::GetNullInstance();
+                if (nursery->Contains(obj))
+                    ColorMarks::Blacken(obj);
             }
+        };
+
+        /*
+            疏散：标记位此时完整且新生代已清空，碎片块中的存活对象搬进新块，旧位置的 next 记下新地址，
+            再从根和全部已标记对象出发修正引用。标记与 mutator 交错进行，不能像 Immix 原文那样边追踪边疏散，
+            所以放在标记结束后单独走一遍；与 Minor GC 一样只发生在分配点上
+        */
+        void evacuate()
+        {
+            std::size_t moved = heap.EvacuateFragmented();
+            if (moved == 0)
+                return;
+            gcStats.objectsEvacuated += moved;
+
+            auto relocate = [](Object *obj) { return obj->next ? obj->next : obj; };
+            relocateRoots(relocate);
+            heap.ForEachMarkedObject([&](Object *obj) {
+                forEachReference(obj, [&](Value &v) {
+                    if (v.IsObject())
+                        v = Value::FromObject(relocate(v.AsObject()));
+                });
+            });
+        }
+#endif
+
+        void recordPause(GCPause kind, Time::Clock::time_point begin)
+        {
+            auto nanos = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Time::Clock::now() - begin).count());
+            gcStats.Pause(kind).Record(nanos);
+            if (nanos > cycleMaxPauseNanos)
+                cycleMaxPauseNanos = nanos;
+        }
+
+        void beginCycleStats()
+        {
+            gcStats.cycles++;
+            gcStats.bytesFreed = heap.FreedBytes() + nurseryFreedBytes;
+            cycleStartStats    = gcStats;
+            cycleMaxPauseNanos = 0;
+        }
 
-            currentFrame = frames;
-            frameLimit   = frames + MAX_RECURSION_DEPTH - 1;
+        // 回收量在堆与新生代里累计，按类型的存活量需要遍历一遍对象，只在读取统计时刷新
+        void refreshGCStats()
+        {
+            gcStats.bytesFreed = heap.FreedBytes() + nurseryFreedBytes;
+            gcStats.liveBytes.fill(0);
+            gcStats.liveObjects.fill(0);
 
-            POISON_MAX_RECURSION_DEPTH_EXCEED_INST =
-                Op::iAsBx(OpCode::Exit_MaxRecursionDepthExceeded, 0, 0);
+            auto count = [this](Object *obj) {
+                auto t = static_cast<std::size_t>(obj->type);
+                gcStats.liveBytes[t] += objectSize(obj);
+                gcStats.liveObjects[t]++;
+            };
+            heap.ForEachObject(count);
+            for (std::byte *p = nursery.Begin(); p < nursery.Top();)
+            {
+                auto *obj = reinterpret_cast<Object *>(p);
+                p += Nursery::AlignSize(objectSize(obj));
+                count(obj);
+            }
+        }
+
+        static double toMiB(std::uint64_t bytes)
+        {
+            return static_cast<double>(bytes) / (1024.0 * 1024.0);
+        }
+
+        static double toMillis(std::uint64_t nanos)
+        {
+            return static_cast<double>(nanos) / 1e6;
+        }
+
+        // 一轮结束 (清扫完) 时打印一行：本轮的停顿次数、最长停顿与前后堆量
+        void traceCycle()
+        {
+            gcStats.bytesFreed = heap.FreedBytes() + nurseryFreedBytes;
+            const GCStats &from = cycleStartStats;
+
+            auto steps = [&](GCPause kind) { return gcStats.Pause(kind).count - from.Pause(kind).count; };
+            auto wall  = std::chrono::duration_cast<std::chrono::nanoseconds>(Time::Clock::now() - gcStats.startTime);
+
+            CoreIO::GetStdErr() << std::format(
+                "[gc] cycle {} @{:.1f}ms: live {:.2f}MiB mapped {:.2f}MiB, alloc {:.2f}MiB freed {:.2f}MiB "
+                "promoted {:.2f}MiB, {} mark + {} sweep steps, {} minor, max pause {:.3f}ms\n",
+                gcStats.cycles,
+                toMillis(static_cast<std::uint64_t>(wall.count())),
+                toMiB(heap.UsedBytes()),
+                toMiB(heap.MappedBytes()),
+                toMiB(gcStats.bytesAllocated - from.bytesAllocated),
+                toMiB(gcStats.bytesFreed - from.bytesFreed),
+                toMiB(gcStats.bytesPromoted - from.bytesPromoted),
+                steps(GCPause::Mark),
+                steps(GCPause::Sweep),
+                gcStats.minorCollections - from.minorCollections,
+                toMillis(cycleMaxPauseNanos));
+        }
+
+        // 常量池字符串执行前登记进驻留表；与已驻留的重复时不标 interned，比较退回按内容
+        void internModuleStrings(const CompiledModule *module)
+        {
+            for (StringObject *str : module->strings)
+            {
+                StringObject *found = strings.Find(str->data, str->hash);
+                if (!found)
+                    strings.Insert(str);
+                str->interned = !found || found == str;
+            }
         }
 
+        // == / != 的非数值情形：字符串比较内容，其余比较身份
+        static bool valuesEqual(Value lhs, Value rhs)
+        {
+            if (lhs.Raw() == rhs.Raw())
+                return true;
+            if (!lhs.IsObject() || !rhs.IsObject())
+                return false;
+            Object *a = lhs.AsObject();
+            Object *b = rhs.AsObject();
+            return a->isString() && b->isString()
+                   && StringEquals(static_cast<StringObject *>(a), static_cast<StringObject *>(b));
+        }
+
+        static bool isIntegral(Value v)
+        {
+            return v.IsInt() || IsBigInt(v);
+        }
+
+        static bool isNumber(Value v)
+        {
+            return v.IsInt() || v.IsDouble() || IsBigInt(v);
+        }
+
+        // Int 或不超过两个 limb 的 BigInt，落在 int64 内时写入 out
+        static bool toInt64(Value v, std::int64_t &out)
+        {
+            if (v.IsInt())
+            {
+                out = v.AsInt();
+                return true;
+            }
+            const BigIntObject *big = AsBigInt(v);
+            if (big->size > 2)
+                return false;
+            std::uint64_t abs = big->limbs[0] | (big->size > 1 ? std::uint64_t{big->limbs[1]} << 32 : 0);
+            if (abs > static_cast<std::uint64_t>(INT64_MAX))
+                return false;
+            out = big->negative ? -static_cast<std::int64_t>(abs) : static_cast<std::int64_t>(abs);
+            return true;
+        }
+
+        static BigInt toBigInt(Value v)
+        {
+            return v.IsInt() ? BigInt::FromInt(v.AsInt()) : AsBigInt(v)->ToBigInt();
+        }
+
+        static double numberToDouble(Value v)
+        {
+            if (v.IsInt())
+                return static_cast<double>(v.AsInt());
+            if (IsBigInt(v))
+                return AsBigInt(v)->ToBigInt().ToDouble();
+            return v.AsDouble();
+        }
+
+        /*
+            至少一边是 BigInt 的数值比较。两边都是整数时精确比较；
+            有 Double 时与 Int/Double 混合比较一样转成 double，NaN 为 unordered
+        */
+        static std::partial_ordering compareNumbers(Value lhs, Value rhs)
+        {
+            if (isIntegral(lhs) && isIntegral(rhs))
+                return toBigInt(lhs) <=> toBigInt(rhs);
+            return numberToDouble(lhs) <=> numberToDouble(rhs);
+        }
+
+        /*
+            算术慢路径：Int 运算溢出 48 位或除零、有 BigInt 参与、操作数不是数。
+            只有这里会分配 BigIntObject；算术指令不是安全点，此时 GC 把当前帧的寄存器全部当作活跃扫描
+        */
+        Result<Value, Error> slowArithmetic(char op, Value lhs, Value rhs)
+        {
+            if (!isNumber(lhs) || !isNumber(rhs))
+            {
+                return std::unexpected(Error(ErrorType::TypeError,
+                    std::format("unsupported operand types for `{}`: {} and {}", op, lhs.ToString(), rhs.ToString()),
+                    "none",
+                    currentLocation()));
+            }
+
+            if (!isIntegral(lhs) || !isIntegral(rhs))
+            {
+                double x = numberToDouble(lhs), y = numberToDouble(rhs);
+                switch (op)
+                {
+                    case '+': return Value::FromDouble(x + y);
+                    case '-': return Value::FromDouble(x - y);
+                    case '*': return Value::FromDouble(x * y);
+                    case '/': return Value::FromDouble(x / y);
+                    default: return Value::FromDouble(std::fmod(x, y));
+                }
+            }
+
+            // 刚越过 48 位的值 (计数、ID、校验和) 最常见：两边都在 int64 内时用 128 位整数算，不经过 limb 数组
+            std::int64_t x, y;
+            if (toInt64(lhs, x) && toInt64(rhs, y)) [[likely]]
+            {
+                __int128 r;
+                switch (op)
+                {
+                    case '+': r = static_cast<__int128>(x) + y; break;
+                    case '-': r = static_cast<__int128>(x) - y; break;
+                    case '*': r = static_cast<__int128>(x) * y; break;
+                    default:
+                        if (y == 0)
+                            return std::unexpected(divisionByZeroError());
+                        r = op == '/' ? static_cast<__int128>(x) / y : static_cast<__int128>(x) % y;
+                        break;
+                }
+                return newInt128(r);
+            }
+
+            BigInt a = toBigInt(lhs), b = toBigInt(rhs);
+            switch (op)
+            {
+                case '+': return NewBigInt(a + b);
+                case '-': return NewBigInt(a - b);
+                case '*': return NewBigInt(a * b);
+                default: break;
+            }
+
+            if (b.IsZero())
+                return std::unexpected(divisionByZeroError());
+            BigInt quot, rem;
+            BigInt::DivMod(a, b, quot, rem);
+            return NewBigInt(op == '/' ? quot : rem);
+        }
+
+        Error divisionByZeroError()
+        {
+            return Error(ErrorType::DivisionByZero, "integer division by zero", "none", currentLocation());
+        }
+
+        Error outOfMemoryError(size_t requested)
+        {
+            if (config.heapLimitBytes == 0)
+            {
+                return Error(ErrorType::OutOfMemory,
+                    std::format("out of memory allocating {} bytes: the system refused to map more heap", requested),
+                    "none",
+                    currentLocation());
+            }
+            return Error(ErrorType::OutOfMemory,
+                std::format("out of memory allocating {} bytes: old generation holds {:.2f}MiB of the {:.2f}MiB limit "
+                            "after a full collection",
+                    requested,
+                    toMiB(heap.UsedBytes()),
+                    toMiB(config.heapLimitBytes)),
+                "use --heap-limit to raise the limit",
+                currentLocation());
+        }
+
+    public:
+        explicit VM(const VMConfig &_config = {}) :
+            config(_config),
+#if defined(__FCORE_GC_IMMIX)
+            heap(finalizeObject, objectSize),
+#else
+            heap(finalizeObject),
+#endif
+            marker(_config.gcThreads), nursery(_config.nurseryBytes)
+        {
+            stack.resize(config.initialStackSlots); // Value() 即 Null
+            frames.resize(config.initialFrames < 2 ? 2 : config.initialFrames);
+            resetFrames();
+        }
+
+        ~VM()
+        {
+            // 对象内存随 nursery / heap 一起释放，这里只析构它们持有的 C++ 资源
+            for (std::byte *p = nursery.Begin(); p < nursery.Top();)
+            {
+                auto *obj = reinterpret_cast<Object *>(p);
+                p += Nursery::AlignSize(objectSize(obj));
+                finalizeObject(obj);
+            }
+            heap.ForEachObject(finalizeObject);
+        }
+
+        VM(const VM &)            = delete;
+        VM &operator=(const VM &) = delete;
+
     private:
+        inline void resetFrames()
+        {
+            currentFrame  = frames.data();
+            *currentFrame = CallFrame{nullptr, nullptr, nullptr, stack.data()};
+        }
+
+        // 寄存器栈扩容到至少 needed 个槽位；超出上限返回 false
+        bool growStack(std::size_t needed)
+        {
+            if (needed > config.maxStackSlots)
+                return false;
+
+            std::size_t newSize = stack.size();
+            while (newSize < needed)
+                newSize *= 2;
+            if (newSize > config.maxStackSlots)
+                newSize = config.maxStackSlots;
+
+            Value *oldBase = stack.data();
+            stack.resize(newSize);
+            Value *newBase = stack.data();
+
+            if (newBase != oldBase)
+            {
+                for (CallFrame *f = frames.data(); f <= currentFrame; ++f)
+                    f->registerBase = newBase + (f->registerBase - oldBase);
+                for (Upvalue *uv = openUpvalues; uv != nullptr; uv = uv->next)
+                    uv->location = newBase + (uv->location - oldBase);
+            }
+            return true;
+        }
+
+        // 调用栈倍增；达到 maxRecursionDepth 返回 false
+        bool growFrames()
+        {
+            std::size_t depth = frames.size() - 1; // 不算哨兵帧
+            if (depth >= config.maxRecursionDepth)
+                return false;
+
+            std::size_t newSize = frames.size() * 2;
+            if (newSize > config.maxRecursionDepth + 1)
+                newSize = config.maxRecursionDepth + 1;
+
+            std::ptrdiff_t current = currentFrame - frames.data();
+            frames.resize(newSize);
+            currentFrame = frames.data() + current;
+            return true;
+        }
+
+        // 在 base 偏移处压入新帧，保证 proto->maxRegisters 个槽位可用
         [[nodiscard]]
-        inline Instruction *pushFrame(Proto *proto, Value *base) // fastcall
+        inline bool pushFrame(FunctionObject *closure, Proto *proto, std::size_t baseOffset)
         {
-            if (++currentFrame >= frameLimit) [[unlikely]] // 达到最大递归层数
+            if (currentFrame + 1 == frames.data() + frames.size()) [[unlikely]]
+            {
+                if (!growFrames())
+                    return false;
+            }
+            if (baseOffset + proto->maxRegisters > stack.size()) [[unlikely]]
             {
-                POISON_MAX_RECURSION_DEPTH_EXCEED_INST =
-                    Op::iAsBx(OpCode::Exit_MaxRecursionDepthExceeded, 0, 0);
-                return &POISON_MAX_RECURSION_DEPTH_EXCEED_INST;
+                if (!growStack(baseOffset + proto->maxRegisters))
+                    return false;
             }
 
-            *currentFrame = CallFrame{nullptr, proto, proto->code.data(), base};
-            return currentFrame->ip;
+            ++currentFrame;
+            *currentFrame = CallFrame{closure, proto, proto->code.data(), stack.data() + baseOffset};
+            return true;
+        }
+
+        [[nodiscard]]
+        inline bool pushFrame(Proto *proto, std::uint8_t baseReg) // fastcall
+        {
+            return pushFrame(nullptr, proto, (currentFrame->registerBase - stack.data()) + baseReg);
         }
 
+        // 尾调用：关闭当前帧的 upvalue，参数下移到 registerBase 后原地替换帧
         [[nodiscard]]
-        inline Instruction *pushFrame(FunctionObject *closure, Value *base) // 普通调用
+        inline bool tailFrame(FunctionObject *closure, Proto *proto, std::uint8_t baseReg, std::uint8_t argc)
         {
-            if (++currentFrame >= frameLimit) [[unlikely]]
+            std::size_t baseOffset = currentFrame->registerBase - stack.data();
+            if (baseOffset + proto->maxRegisters > stack.size()) [[unlikely]]
             {
-                POISON_MAX_RECURSION_DEPTH_EXCEED_INST =
-                    Op::iAsBx(OpCode::Exit_MaxRecursionDepthExceeded, 0, 0);
-                return &POISON_MAX_RECURSION_DEPTH_EXCEED_INST;
+                if (!growStack(baseOffset + proto->maxRegisters))
+                    return false;
             }
 
-            *currentFrame = CallFrame{closure, closure->proto, closure->proto->code.data(), base};
-            return currentFrame->ip;
+            Value *base = currentFrame->registerBase;
+            closeUpvalues(base);
+
+            for (std::uint8_t i = 0; i < argc; ++i)
+            {
+                base[i] = base[baseReg + i];
+            }
+
+            currentFrame->closure = closure;
+            currentFrame->proto   = proto;
+            currentFrame->ip      = proto->code.data();
+            return true;
+        }
+
+        /*
+            从当前 ip 进入 Proto 的机器码，返回后 ip 指向机器码未执行的指令。
+            countHot: 调用入口 / 回边处计数，达到阈值时编译；返回点只负责重新进入。
+        */
+        inline void jitEnter(bool countHot)
+        {
+            Proto *proto = currentFrame->proto;
+            if (!proto->jitCode)
+            {
+                if (!countHot || ++proto->hotCount != config.jitThreshold)
+                    return;
+                proto->jitCode = jit.Compile(proto);
+                if (!proto->jitCode)
+                    return;
+            }
+
+            auto pc = static_cast<std::uint32_t>(currentFrame->ip - proto->code.data());
+            pc      = proto->jitCode->entry(currentFrame->registerBase, globals.data(), pc);
+            currentFrame->ip = proto->code.data() + pc;
+        }
+
+        /*
+            调用点内联缓存：callee 与该 Call 上次调用的闭包位模式相同时直接复用缓存的
+            闭包与 Proto，省去 IsObject / isFunction 检查与 proto 加载；
+            未命中时检查并回填。不可调用返回 nullptr
+        */
+        inline const CallSiteCache *lookupCallSite(Value callee)
+        {
+            Proto         *proto = currentFrame->proto;
+            CallSiteCache &ic    = proto->callCache[currentFrame->ip - 1 - proto->code.data()];
+            if (callee.Raw() == ic.calleeBits) [[likely]]
+                return &ic;
+
+            if (!callee.IsObject() || !callee.AsObject()->isFunction())
+                return nullptr;
+
+            auto *closure = static_cast<FunctionObject *>(callee.AsObject());
+            ic            = CallSiteCache{callee.Raw(), closure, closure->proto};
+            return &ic;
+        }
+
+        /*
+            静态字段站点：编译器把接收者静态类型对应的结构体与槽位预置在该 pc 的 fieldCache 中。
+            经 Any 传入的值可能绕过 Analyzer，所以仍比较 klass；不同时按字段名在实际结构体里查找 (同 GetFieldK)。
+            接收者不是实例或没有该字段返回 -1
+        */
+        inline int staticFieldSlot(Value recv)
+        {
+            if (!recv.IsObject() || !recv.AsObject()->isInstance()) [[unlikely]]
+                return -1;
+
+            StructObject         *klass = recv.AsObject()->klass;
+            Proto                *proto = currentFrame->proto;
+            const FieldSiteCache &site  = proto->fieldCache[currentFrame->ip - 1 - proto->code.data()];
+            if (klass == site.klass) [[likely]]
+                return site.slot;
+            return klass->FieldIndex(site.klass->fieldNames[site.slot]);
+        }
+
+        /*
+            字段访问内联缓存：接收者的 klass 与该指令上次见到的相同时直接用缓存的槽位；
+            未命中时按名字在结构体里查找并回填 (单态，换结构体就覆盖)。
+            接收者不是实例或没有该字段返回 -1
+        */
+        inline int lookupFieldSite(Value recv, Value name)
+        {
+            if (!recv.IsObject() || !recv.AsObject()->isInstance()) [[unlikely]]
+                return -1;
+
+            StructObject   *klass = recv.AsObject()->klass;
+            Proto          *proto = currentFrame->proto;
+            FieldSiteCache &ic    = proto->fieldCache[currentFrame->ip - 1 - proto->code.data()];
+            if (klass == ic.klass) [[likely]]
+                return ic.slot;
+
+            int slot = klass->FieldIndex(static_cast<StringObject *>(name.AsObject())->data);
+            if (slot >= 0)
+                ic = FieldSiteCache{klass, static_cast<std::uint8_t>(slot)};
+            return slot;
+        }
+
+        Error fieldNameError(Value recv, const String &name)
+        {
+            return Error(ErrorType::TypeError,
+                std::format("Object `{}` has no field named `{}`", recv.ToString(), name),
+                "none",
+                currentLocation());
+        }
+
+        Error fieldNameError(Value recv, Value name)
+        {
+            return fieldNameError(recv, static_cast<StringObject *>(name.AsObject())->data);
+        }
+
+        // 静态字段站点未找到字段时，报告期望结构体里该槽位的字段名
+        Error staticFieldError(Value recv)
+        {
+            Proto                *proto = currentFrame->proto;
+            const FieldSiteCache &site  = proto->fieldCache[currentFrame->ip - 1 - proto->code.data()];
+            return fieldNameError(recv, site.klass->fieldNames[site.slot]);
+        }
+
+        /*
+            原生调用：参数窗口就是 registerBase[baseReg, baseReg + argc)，结果写回 registerBase[baseReg]。
+            原生函数可能分配对象触发 GC 步进，但不会压帧，寄存器栈不会搬迁
+        */
+        [[nodiscard]]
+        inline Result<void, Error> callNative(
+            const NativeFunctionObject *native, std::uint8_t baseReg, std::uint8_t argc)
+        {
+            Value *args = currentFrame->registerBase + baseReg;
+            auto   res  = native->fn(*this, args, argc);
+            if (!res) [[unlikely]]
+            {
+                Error err    = std::move(res.error());
+                err.location = currentLocation();
+                return std::unexpected(std::move(err));
+            }
+            *args = *res;
+            return {};
+        }
+
+        // 经由 Call / TailCall 动态调用原生函数时才需要的参数个数检查 (CallNative 由 Analyzer 检查)
+        Error nativeArityError(const NativeFunctionObject *native, std::uint8_t argc)
+        {
+            return Error(ErrorType::TypeError,
+                std::format("native function `{}` expects {} arguments, got {}", native->name, native->arity, argc),
+                "none",
+                currentLocation());
+        }
+
+        /*
+            运行时特化 (quickening)。ip 已指向下一条，ip[-1] 即正在执行的指令。
+            泛型指令以某个特化形式对应的类型组合执行完后调用 quickenHit，
+            连续命中 quickenThreshold << deopts 次后把 ip[-1] 原地改写为该形式。
+        */
+        inline QuickenSlot &quickenSlot()
+        {
+            Proto *proto = currentFrame->proto;
+            return proto->quicken[currentFrame->ip - 1 - proto->code.data()];
+        }
+
+        inline void quickenHit(Instruction inst, OpCode specialized)
+        {
+            QuickenSlot &slot = quickenSlot();
+            if (slot.deopts >= config.maxQuickenDeopts)
+                return;
+
+            auto tag = static_cast<std::uint8_t>(specialized);
+            if (slot.lastOp != tag)
+            {
+                slot.lastOp = tag;
+                slot.warmup = 0;
+            }
+            if (++slot.warmup < (config.quickenThreshold << slot.deopts))
+                return;
+
+            slot.warmup          = 0;
+            currentFrame->ip[-1] = (inst & ~Instruction(0xFF)) | tag;
+#if defined(__FCORE_QUICKEN_STATS)
+            ++quickenCount[tag];
+#endif
+        }
+
+        // 类型组合不属于任何特化形式 (如 Int + Double)
+        inline void quickenMiss()
+        {
+            quickenSlot().warmup = 0;
+        }
+
+        // 特化指令守卫失败：改回泛型指令，之后需要更多次命中才会再次特化
+        inline void dequicken(Instruction inst, OpCode generic)
+        {
+            QuickenSlot &slot = quickenSlot();
+            ++slot.deopts;
+            slot.warmup          = 0;
+            currentFrame->ip[-1] = (inst & ~Instruction(0xFF)) | static_cast<std::uint8_t>(generic);
+#if defined(__FCORE_QUICKEN_STATS)
+            ++dequickenCount[inst & 0xFF];
+#endif
+        }
+
+        /*
+            回边刚跳到循环头 (ip 指向循环头，backEdgePc 为回边 Jmp 的 pc)。
+            热循环先记录成 trace，之后每次回边直接进入 trace，侧出口后 ip 指向恢复点。
+        */
+        inline void traceEnter(std::uint32_t backEdgePc)
+        {
+            Proto *proto = currentFrame->proto;
+            if (proto->loopAnchors.empty())
+                proto->loopAnchors.resize(proto->code.size());
+
+            auto        headerPc = static_cast<std::uint32_t>(currentFrame->ip - proto->code.data());
+            LoopAnchor &anchor   = proto->loopAnchors[headerPc];
+            if (!anchor.trace)
+            {
+                if (anchor.aborts >= Jit::TraceJit::MaxAborts || ++anchor.hits < config.traceThreshold)
+                    return;
+                anchor.trace = traceJit.Record(
+                    proto, headerPc, backEdgePc, currentFrame->registerBase, globals.data(), globals.size());
+                if (!anchor.trace)
+                {
+                    ++anchor.aborts;
+                    anchor.hits = 0;
+                    return;
+                }
+            }
+
+            std::uint32_t pc = anchor.trace->entry(currentFrame->registerBase, globals.data());
+            currentFrame->ip = proto->code.data() + pc;
+        }
+
+        // 当前指令的源码位置 (ip 已指向下一条)
+        const SourceLocation &currentLocation()
+        {
+            return *currentFrame->proto->locations[currentFrame->ip - currentFrame->proto->code.data() - 1];
+        }
+
+        Error stackOverflowError()
+        {
+            return Error(ErrorType::StackOverflow,
+                std::format("stack overflow in Fn `{}`: max recursion depth {}, max stack slots {}",
+                    currentFrame->proto->name,
+                    config.maxRecursionDepth,
+                    config.maxStackSlots),
+                "use --max-recursion-depth to raise the limit",
+                currentLocation());
         }
 
         inline void popFrame()
@@ -377,17 +1564,116 @@ namespace Fig
         {
             return static_cast<std::int16_t>(inst >> 16);
         }
+        inline std::int8_t decodeSC(Instruction inst)
+        {
+            return static_cast<std::int8_t>(inst >> 24);
+        }
 
     public:
         // 执行入口：接收 Proto
         Result<Value, Error> Execute(CompiledModule *);
 
+        /*
+            供原生函数构造字符串结果。标识符样式的短串先查驻留表，已有相同内容的直接复用；
+            标记期间复用的对象可能还是白色，顺手着色
+        */
+        Result<Value, Error> NewString(const String &data)
+        {
+            std::uint32_t hash   = StringHash(data);
+            bool          intern = StringTable::ShouldIntern(data);
+            if (intern)
+            {
+                if (StringObject *found = strings.Find(data, hash))
+                {
+                    if (gcPhase == GCPhase::Marking)
+                        markValue(Value::FromObject(found));
+                    return Value::FromObject(found);
+                }
+            }
+
+            auto *str = allocateObject<StringObject>(ObjectType::String, 0);
+            if (!str) [[unlikely]]
+                return std::unexpected(outOfMemoryError(sizeof(StringObject)));
+            new (&str->data) String(data);
+            str->hash     = hash;
+            str->interned = intern;
+            if (intern)
+            {
+                strings.Insert(str);
+                if (isYoung(str))
+                    youngStrings.push_back(str);
+            }
+            return Value::FromObject(str);
+        }
+
+        /*
+            整数结果装箱：落在 Int 范围内的退回 Int，否则分配 BigIntObject。
+            保持规范形式，BigInt 与 Int 的值域不相交
+        */
+        Result<Value, Error> NewBigInt(const BigInt &v)
+        {
+            std::int64_t small;
+            if (v.ToInt64(small) && Value::FitsInt(small))
+                return Value::FromInt(small);
+            return newBigIntObject(v.Limbs(), v.IsNegative());
+        }
+
+    private:
+        Result<Value, Error> newBigIntObject(std::span<const BigInt::Limb> limbs, bool negative)
+        {
+            size_t extra = limbs.size() * sizeof(BigInt::Limb);
+            auto  *obj   = allocateObject<BigIntObject>(ObjectType::BigInt, extra);
+            if (!obj) [[unlikely]]
+                return std::unexpected(outOfMemoryError(sizeof(BigIntObject) + extra));
+            obj->negative = negative;
+            obj->size     = static_cast<std::uint32_t>(limbs.size());
+            std::copy(limbs.begin(), limbs.end(), obj->limbs);
+            return Value::FromObject(obj);
+        }
+
+        /*
+            NewInstance：字段值就是寄存器窗口 R[base, base + fieldCount)，一次拷进 fields[]。
+            分配可能触发 GC (会改写窗口里被搬动的引用)，因此分配之后再读窗口。
+            新生代对象且不在标记中时无需逐个过写屏障
+        */
+        Result<Value, Error> newInstance(StructObject *klass, std::uint8_t base)
+        {
+            size_t extra = klass->fieldCount * sizeof(Value);
+            auto  *obj   = allocateObject<InstanceObject>(ObjectType::Instance, extra);
+            if (!obj) [[unlikely]]
+                return std::unexpected(outOfMemoryError(sizeof(InstanceObject) + extra));
+            obj->klass = klass;
+            std::memcpy(obj->fields, currentFrame->registerBase + base, extra);
+
+            if (!isYoung(obj) || gcPhase == GCPhase::Marking)
+            {
+                for (std::uint8_t i = 0; i < klass->fieldCount; ++i)
+                    writeBarrier(obj, obj->fields[i]);
+            }
+            return Value::FromObject(obj);
+        }
+
+        // 128 位中间结果装箱，与 NewBigInt 一样保持规范形式
+        Result<Value, Error> newInt128(__int128 r)
+        {
+            if (r >= Value::IntMin && r <= Value::IntMax)
+                return Value::FromInt(static_cast<std::int64_t>(r));
+
+            auto abs = static_cast<unsigned __int128>(r < 0 ? -r : r);
+            std::array<BigInt::Limb, 4> limbs;
+            std::size_t                 n = 0;
+            for (; abs != 0; abs >>= 32)
+                limbs[n++] = static_cast<BigInt::Limb>(abs);
+            return newBigIntObject({limbs.data(), n}, r < 0);
+        }
+
+    public:
         void PrintRegisters(std::ostream &ostream = CoreIO::GetStdOut())
         {
             ostream << "=== Registers ===\n";
-            for (unsigned int i = 0; i < MAX_REGISTERS; ++i)
+            for (std::size_t i = 0; i < stack.size(); ++i)
             {
-                Value &v = registers[i];
+                Value &v = stack[i];
                 if (!v.IsNull())
                 {
                     ostream << std::format("[{}] {}\n", i, v.ToString());
@@ -398,7 +1684,7 @@ namespace Fig
         void PrintGlobals(std::ostream &ostream = CoreIO::GetStdOut()) 
         {
             ostream << "== Globals ===\n";
-            for (unsigned int i = 0; i < MAX_GLOBALS; ++i)
+            for (std::size_t i = 0; i < globals.size(); ++i)
             {
                 Value &v = globals[i];
                 if (!v.IsNull())
@@ -407,5 +1693,83 @@ namespace Fig
                 }
             }
         }
+
+        const GCStats &GetGCStats()
+        {
+            refreshGCStats();
+            return gcStats;
+        }
+
+        void PrintGCSummary(std::ostream &ostream = CoreIO::GetStdErr())
+        {
+            const GCStats &stats   = GetGCStats();
+            double         seconds = std::chrono::duration<double>(Time::Clock::now() - stats.startTime).count();
+
+            ostream << "=== GC ===\n";
+            ostream << std::format("cycles {}, minor collections {}, elapsed {:.3f}s\n",
+                stats.cycles,
+                stats.minorCollections,
+                seconds);
+            ostream << std::format("allocated {:.2f}MiB in {} objects ({:.1f}MiB/s)\n",
+                toMiB(stats.bytesAllocated),
+                stats.objectsAllocated,
+                seconds > 0 ? toMiB(stats.bytesAllocated) / seconds : 0.0);
+            ostream << std::format("freed {:.2f}MiB, promoted {:.2f}MiB in {} objects, evacuated {} objects\n",
+                toMiB(stats.bytesFreed),
+                toMiB(stats.bytesPromoted),
+                stats.objectsPromoted,
+                stats.objectsEvacuated);
+            ostream << std::format("old generation used {:.2f}MiB, mapped {:.2f}MiB\n",
+                toMiB(heap.UsedBytes()),
+                toMiB(heap.MappedBytes()));
+
+            ostream << std::format("{:<10} {:>8} {:>10} {:>9} {:>8} {:>8} {:>9}\n",
+                "pause", "count", "total ms", "mean us", "p50 <us", "p99 <us", "max us");
+            for (std::size_t k = 0; k < stats.pauses.size(); ++k)
+            {
+                const PauseHistogram &h = stats.pauses[k];
+                if (h.count == 0)
+                    continue;
+                ostream << std::format("{:<10} {:>8} {:>10.3f} {:>9.1f} {:>8} {:>8} {:>9.1f}\n",
+                    magic_enum::enum_name(static_cast<GCPause>(k)),
+                    h.count,
+                    toMillis(h.totalNanos),
+                    static_cast<double>(h.totalNanos) / 1e3 / static_cast<double>(h.count),
+                    h.PercentileMicros(0.50),
+                    h.PercentileMicros(0.99),
+                    static_cast<double>(h.maxNanos) / 1e3);
+            }
+
+            // 退出时老年代可能还有未清扫的垃圾，这里是 "尚未回收" 而非严格存活
+            ostream << "heap objects by type:\n";
+            for (std::size_t t = 0; t < ObjectTypeCount; ++t)
+            {
+                if (stats.liveObjects[t] == 0)
+                    continue;
+                ostream << std::format("  {:<12} {:>10} {:>12.2f}KiB\n",
+                    magic_enum::enum_name(static_cast<ObjectType>(t)),
+                    stats.liveObjects[t],
+                    static_cast<double>(stats.liveBytes[t]) / 1024.0);
+            }
+        }
+
+        void PrintQuickenStats(std::ostream &ostream = CoreIO::GetStdErr())
+        {
+#if defined(__FCORE_QUICKEN_STATS)
+            ostream << "=== Quickening ===\n";
+            for (std::size_t op = 0; op < quickenCount.size(); ++op)
+            {
+                if (quickenCount[op] || dequickenCount[op])
+                {
+                    ostream << std::format("{:<24} quickened {:>8}  deopt {:>8}\n",
+                        magic_enum::enum_name(static_cast<OpCode>(op)),
+                        quickenCount[op],
+                        dequickenCount[op]);
+                }
+            }
+#else
+            ostream << "quickening statistics are only collected in debug builds\n";
+#endif
+        }
     };
 } // namespace Fig
\ No newline at end of file
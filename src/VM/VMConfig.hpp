@@ -0,0 +1,58 @@
+/*!
+    @file src/VM/VMConfig.hpp
+    @brief 虚拟机运行时参数
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Fig
+{
+    struct VMConfig
+    {
+        // 调用栈深度上限 (CallFrame 个数)，超出报 StackOverflow
+        std::size_t maxRecursionDepth = 200000;
+
+        // 寄存器栈上限 (Value 个数，默认 16M 个 = 128MB)
+        std::size_t maxStackSlots = std::size_t(1) << 24;
+
+        // 初始容量，按需倍增
+        std::size_t initialStackSlots = 256;
+        std::size_t initialFrames     = 64;
+
+        // 新生代大小 (--nursery-size，单位 KB)：写满后 Minor GC 晋升存活对象
+        std::size_t nurseryBytes = std::size_t(1) << 20;
+
+        // 老年代标记线程数 (--gc-threads)：1 为 mutator 上的增量标记；
+        // 大于 1 时每轮在一次停顿内并行标记并清扫
+        std::size_t gcThreads = 1;
+
+        // 增量 GC 节奏：一轮开始后每分配 gcStepBytes 字节做一步，
+        // 每步至多工作 gcStepMicros 微秒 (--gc-step-us)
+        std::size_t   gcStepBytes  = 64 * 1024;
+        std::uint32_t gcStepMicros = 100;
+
+        // 老年代上限 (--heap-limit，单位 MB，0 为不限)：分配会越过上限时先做一次完整的同步回收，
+        // 仍放不下则报 OutOfMemory。新生代 (nurseryBytes) 另计；晋升不能中途失败，最多越过一个新生代
+        std::size_t heapLimitBytes = 0;
+
+        // --gc-trace：每轮回收结束向 stderr 打印一行，退出时打印停顿直方图与汇总
+        bool gcTrace = false;
+
+        // 运行时特化：泛型指令连续 quickenThreshold << deopts 次命中同一类型组合后改写，
+        // 退回泛型达到 maxQuickenDeopts 次后该指令不再特化 (--no-quicken 即置 0)
+        std::uint8_t quickenThreshold = 8;
+        std::uint8_t maxQuickenDeopts = 4;
+        bool         quickenStats     = false; // --quicken-stats，仅调试构建有统计
+
+        // 基线 JIT (--jit)：Proto 的调用 + 回边次数达到阈值后编译为机器码
+        bool          enableJit    = false;
+        std::uint32_t jitThreshold = 1000;
+
+        // 追踪 JIT (--trace-jit)：循环头的回边次数达到阈值后记录一次迭代并编译
+        bool          enableTraceJit = false;
+        std::uint32_t traceThreshold = 50;
+    };
+} // namespace Fig
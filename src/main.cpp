@@ -10,6 +10,8 @@
 
 #include <Utils/ArgParser/ArgParser.hpp>
 
+#include <charconv>
+
 int main(int argc, char **argv)
 {
     using namespace Fig;
@@ -22,6 +24,16 @@ int main(int argc, char **argv)
     argparser.AddFlag('h', "help").Help("Print the help message");
     argparser.AddFlag('v', "version").Help("Show toolchain version");
     argparser.AddFlag("license").Help("Print the license text");
+    argparser.AddOption("max-recursion-depth").Help("Max call depth of the VM (default 200000)");
+    argparser.AddOption("nursery-size").Help("Young generation size in KB (default 1024)");
+    argparser.AddOption("gc-threads").Help("Mark the old generation with N threads in one pause (default 1: incremental)");
+    argparser.AddOption("heap-limit").Help("Old generation limit in MB, 0 for unlimited (default 0)");
+    argparser.AddOption("gc-step-us").Help("Time budget of one incremental GC step in microseconds (default 100)");
+    argparser.AddFlag("gc-trace").Help("Print one line per GC cycle and a pause/allocation summary on exit");
+    argparser.AddFlag("jit").Help("Compile hot functions and loops to x86-64 machine code");
+    argparser.AddFlag("no-quicken").Help("Disable runtime specialisation of generic arithmetic/compare opcodes");
+    argparser.AddFlag("quicken-stats").Help("Print runtime specialisation counters on exit (debug builds)");
+    argparser.AddFlag("trace-jit").Help("Record hot while-loops as type-specialized machine code traces");
 
     auto res = argparser.Parse(argc, argv);
     if (!res)
@@ -77,8 +89,78 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    VMConfig config;
+    if (auto depth = args.GetOption("max-recursion-depth"))
+    {
+        std::string raw = depth->toStdString();
+        auto [ptr, ec]  = std::from_chars(raw.data(), raw.data() + raw.size(), config.maxRecursionDepth);
+        if (ec != std::errc() || ptr != raw.data() + raw.size() || config.maxRecursionDepth == 0)
+        {
+            err << "Error: --max-recursion-depth expects a positive integer\n";
+            return 1;
+        }
+    }
+
+    if (auto nursery = args.GetOption("nursery-size"))
+    {
+        std::string raw = nursery->toStdString();
+        std::size_t kb  = 0;
+        auto [ptr, ec]  = std::from_chars(raw.data(), raw.data() + raw.size(), kb);
+        if (ec != std::errc() || ptr != raw.data() + raw.size() || kb == 0)
+        {
+            err << "Error: --nursery-size expects a positive integer (KB)\n";
+            return 1;
+        }
+        config.nurseryBytes = kb * 1024;
+    }
+
+    if (auto limit = args.GetOption("heap-limit"))
+    {
+        std::string raw = limit->toStdString();
+        std::size_t mb  = 0;
+        auto [ptr, ec]  = std::from_chars(raw.data(), raw.data() + raw.size(), mb);
+        if (ec != std::errc() || ptr != raw.data() + raw.size())
+        {
+            err << "Error: --heap-limit expects a non-negative integer (MB)\n";
+            return 1;
+        }
+        config.heapLimitBytes = mb * 1024 * 1024;
+    }
+
+    if (auto threads = args.GetOption("gc-threads"))
+    {
+        std::string raw = threads->toStdString();
+        auto [ptr, ec]  = std::from_chars(raw.data(), raw.data() + raw.size(), config.gcThreads);
+        if (ec != std::errc() || ptr != raw.data() + raw.size() || config.gcThreads == 0
+            || config.gcThreads > 256)
+        {
+            err << "Error: --gc-threads expects an integer in [1, 256]\n";
+            return 1;
+        }
+    }
+
+    if (auto step = args.GetOption("gc-step-us"))
+    {
+        std::string raw = step->toStdString();
+        auto [ptr, ec]  = std::from_chars(raw.data(), raw.data() + raw.size(), config.gcStepMicros);
+        if (ec != std::errc() || ptr != raw.data() + raw.size() || config.gcStepMicros == 0)
+        {
+            err << "Error: --gc-step-us expects a positive integer\n";
+            return 1;
+        }
+    }
+
+    config.enableJit      = args.HasFlag("jit");
+    config.enableTraceJit = args.HasFlag("trace-jit");
+    config.quickenStats   = args.HasFlag("quicken-stats");
+    config.gcTrace        = args.HasFlag("gc-trace");
+    if (args.HasFlag("no-quicken"))
+    {
+        config.maxQuickenDeopts = 0;
+    }
+
     const String &path = positionals.front();
-    Entry::RunFromPath(path);
+    Entry::RunFromPath(path, config);
 
     return 0;
 }
\ No newline at end of file
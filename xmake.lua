@@ -20,6 +20,21 @@ add_includedirs("src")
 
 add_defines("__FCORE_COMPILE_TIME=\"" .. os.date("%Y-%m-%d %H:%M:%S") .. "\"")
 
+if is_mode("debug") then
+    add_defines("__FCORE_QUICKEN_STATS") -- VM 运行时特化计数 (--quicken-stats)
+end
+
+-- 老年代改用 Immix 式标记-区域堆 (xmake f --gc-immix=y)
+option("gc-immix")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Use the Immix mark-region old generation instead of the size-class page heap")
+option_end()
+
+if has_config("gc-immix") then
+    add_defines("__FCORE_GC_IMMIX")
+end
+
 target("StringTest")
     add_files("src/Deps/String/StringTest.cpp")
     
@@ -44,6 +59,7 @@ target("ParserTest")
 
 target("ObjectTest")
     add_files("src/Object/Object.cpp")
+    add_files("src/Object/BigInt.cpp")
     add_files("src/Object/ObjectTest.cpp")
 
 target("AnalyzerTest")
@@ -72,10 +88,13 @@ target("CompilerTest")
     add_files("src/Parser/TypeExprParser.cpp")
     add_files("src/Parser/Parser.cpp")
     add_files("src/Object/Object.cpp")
+    add_files("src/Object/BigInt.cpp")
     add_files("src/Sema/Type.cpp")
     add_files("src/Sema/Analyzer.cpp")
     add_files("src/Compiler/ExprCompiler.cpp")
     add_files("src/Compiler/StmtCompiler.cpp")
+    add_files("src/Compiler/Peephole.cpp")
+    add_files("src/Compiler/Liveness.cpp")
     add_files("src/Compiler/Compiler.cpp")
     add_files("src/Compiler/CompileTest.cpp")
 
@@ -106,12 +125,18 @@ target("ReplTest")
     add_files("src/Parser/TypeExprParser.cpp")
     add_files("src/Parser/Parser.cpp")
     add_files("src/Object/Object.cpp")
+    add_files("src/Object/BigInt.cpp")
     add_files("src/Sema/Type.cpp")
     add_files("src/Sema/Analyzer.cpp")
     add_files("src/Compiler/ExprCompiler.cpp")
     add_files("src/Compiler/StmtCompiler.cpp")
+    add_files("src/Compiler/Peephole.cpp")
+    add_files("src/Compiler/Liveness.cpp")
     add_files("src/Compiler/Compiler.cpp")
+    add_files("src/JIT/*.cpp")
+    add_files("src/Std/*.cpp")
     add_files("src/VM/VM.cpp")
+    add_files("src/VM/PageHeap.cpp")
     add_files("src/Repl/ReplTest.cpp")
 
 target("Fig")
@@ -132,10 +157,16 @@ target("Fig")
 
     add_files("src/Compiler/ExprCompiler.cpp")
     add_files("src/Compiler/StmtCompiler.cpp")
+    add_files("src/Compiler/Peephole.cpp")
+    add_files("src/Compiler/Liveness.cpp")
     add_files("src/Compiler/Compiler.cpp")
     add_files("src/Bytecode/Disassembler.cpp")
 
     add_files("src/Object/Object.cpp")
+    add_files("src/Object/BigInt.cpp")
+    add_files("src/JIT/*.cpp")
+    add_files("src/Std/*.cpp")
     add_files("src/VM/VM.cpp")
+    add_files("src/VM/PageHeap.cpp")
     add_files("src/VM/Entry.cpp")
     add_files("src/main.cpp")